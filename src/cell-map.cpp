@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 Incognito
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "main.h"
+
+#include "cell-map.h"
+
+CellMap::CellMap()
+{
+	clear();
+}
+
+void CellMap::clear()
+{
+	count = 0;
+	mask = 15;
+	slots.clear();
+	slots.resize(mask + 1);
+}
+
+void CellMap::erase(const CellId &cellId)
+{
+	std::uint64_t key = getKey(cellId);
+	std::size_t index = getHash(key) & mask;
+	while (slots[index].cell)
+	{
+		if (slots[index].key == key)
+		{
+			slots[index].cell.reset();
+			--count;
+			std::size_t next = (index + 1) & mask;
+			while (slots[next].cell)
+			{
+				std::size_t ideal = getHash(slots[next].key) & mask;
+				if (((next - ideal) & mask) >= ((next - index) & mask))
+				{
+					slots[index].key = slots[next].key;
+					slots[index].cell.swap(slots[next].cell);
+					index = next;
+				}
+				next = (next + 1) & mask;
+			}
+			return;
+		}
+		index = (index + 1) & mask;
+	}
+}
+
+SharedCell *CellMap::find(const CellId &cellId)
+{
+	std::uint64_t key = getKey(cellId);
+	std::size_t index = getHash(key) & mask;
+	while (slots[index].cell)
+	{
+		if (slots[index].key == key)
+		{
+			return &slots[index].cell;
+		}
+		index = (index + 1) & mask;
+	}
+	return NULL;
+}
+
+SharedCell &CellMap::insert(const CellId &cellId, const SharedCell &cell)
+{
+	if ((count + 1) * 4 > slots.size() * 3)
+	{
+		grow();
+	}
+	std::uint64_t key = getKey(cellId);
+	std::size_t index = getHash(key) & mask;
+	while (slots[index].cell)
+	{
+		if (slots[index].key == key)
+		{
+			return slots[index].cell;
+		}
+		index = (index + 1) & mask;
+	}
+	slots[index].key = key;
+	slots[index].cell = cell;
+	++count;
+	return slots[index].cell;
+}
+
+void CellMap::grow()
+{
+	std::vector<Slot> oldSlots;
+	oldSlots.swap(slots);
+	mask = (mask << 1) | 1;
+	slots.resize(mask + 1);
+	for (std::vector<Slot>::iterator s = oldSlots.begin(); s != oldSlots.end(); ++s)
+	{
+		if (s->cell)
+		{
+			std::size_t index = getHash(s->key) & mask;
+			while (slots[index].cell)
+			{
+				index = (index + 1) & mask;
+			}
+			slots[index].key = s->key;
+			slots[index].cell.swap(s->cell);
+		}
+	}
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2017 Incognito
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CELL_MAP_H
+#define CELL_MAP_H
+
+#include "cell.h"
+
+class CellMap
+{
+public:
+	struct Slot
+	{
+		std::uint64_t key;
+		SharedCell cell;
+	};
+
+	class iterator
+	{
+	public:
+		iterator(std::vector<Slot> *passedSlots, std::size_t passedIndex) : slots(passedSlots), index(passedIndex)
+		{
+			skipEmptySlots();
+		}
+
+		inline SharedCell &operator*()
+		{
+			return (*slots)[index].cell;
+		}
+
+		inline iterator &operator++()
+		{
+			++index;
+			skipEmptySlots();
+			return *this;
+		}
+
+		inline bool operator==(const iterator &other) const
+		{
+			return index == other.index;
+		}
+
+		inline bool operator!=(const iterator &other) const
+		{
+			return index != other.index;
+		}
+	private:
+		std::vector<Slot> *slots;
+		std::size_t index;
+
+		inline void skipEmptySlots()
+		{
+			while (index < slots->size() && !(*slots)[index].cell)
+			{
+				++index;
+			}
+		}
+	};
+
+	CellMap();
+
+	inline iterator begin()
+	{
+		return iterator(&slots, 0);
+	}
+
+	inline iterator end()
+	{
+		return iterator(&slots, slots.size());
+	}
+
+	inline bool empty()
+	{
+		return !count;
+	}
+
+	inline std::size_t size()
+	{
+		return count;
+	}
+
+	static inline std::uint64_t getKey(const CellId &cellId)
+	{
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellId.first)) << 32) | static_cast<std::uint64_t>(static_cast<std::uint32_t>(cellId.second));
+	}
+
+	void clear();
+	void erase(const CellId &cellId);
+	SharedCell *find(const CellId &cellId);
+	SharedCell &insert(const CellId &cellId, const SharedCell &cell);
+private:
+	std::size_t count;
+	std::size_t mask;
+
+	std::vector<Slot> slots;
+
+	static inline std::size_t getHash(std::uint64_t key)
+	{
+		key ^= key >> 33;
+		key *= 0xFF51AFD7ED558CCDULL;
+		key ^= key >> 33;
+		key *= 0xC4CEB9FE1A85EC53ULL;
+		key ^= key >> 33;
+		return static_cast<std::size_t>(key);
+	}
+
+	void grow();
+};
+
+#endif
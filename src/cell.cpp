@@ -18,5 +18,5 @@
 
 #include "cell.h"
 
-Cell::Cell() : references(0) {}
-Cell::Cell(CellId passedCellId) : cellId(passedCellId), references(0) {}
+Cell::Cell() : level(0), comparableStreamDistance(-1.0f), height(std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()), partitionId(-1, -1), references(0) {}
+Cell::Cell(CellId passedCellId, int passedLevel) : cellId(passedCellId), level(passedLevel), comparableStreamDistance(-1.0f), height(std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()), partitionId(-1, -1), references(0) {}
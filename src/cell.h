@@ -23,11 +23,17 @@ class Cell
 {
 public:
 	Cell();
-	Cell(CellId cellId);
+	Cell(CellId cellId, int level);
 
 	CellId cellId;
+	int level;
+	float comparableStreamDistance;
+	Eigen::Vector2f height;
+	PartitionId partitionId;
 	int references;
 
+	std::unordered_map<PartitionId, SharedCell, pair_hash> partitions;
+
 	std::unordered_map<int, Item::SharedActor> actors;
 	std::unordered_map<int, Item::SharedArea> areas;
 	std::unordered_map<int, Item::SharedCheckpoint> checkpoints;
@@ -36,6 +42,8 @@ public:
 	std::unordered_map<int, Item::SharedPickup> pickups;
 	std::unordered_map<int, Item::SharedRaceCheckpoint> raceCheckpoints;
 	std::unordered_map<int, Item::SharedTextLabel> textLabels;
+
+	std::vector<Item::FrozenObject> frozenObjects;
 };
 
 #endif
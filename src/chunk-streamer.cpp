@@ -24,7 +24,12 @@ ChunkStreamer::ChunkStreamer()
 	chunkSize[STREAMER_TYPE_OBJECT] = 100;
 	chunkSize[STREAMER_TYPE_MAP_ICON] = 100;
 	chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = 100;
+	configuredChunkSize[STREAMER_TYPE_OBJECT] = 100;
+	configuredChunkSize[STREAMER_TYPE_MAP_ICON] = 100;
+	configuredChunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = 100;
+	chunkSizeLimits = std::make_tuple(1, 1000);
 	chunkStreamingEnabled = false;
+	chunkTargetTime = 0.0f;
 }
 
 std::size_t ChunkStreamer::getChunkSize(int type)
@@ -33,15 +38,15 @@ std::size_t ChunkStreamer::getChunkSize(int type)
 	{
 		case STREAMER_TYPE_OBJECT:
 		{
-			return chunkSize[STREAMER_TYPE_OBJECT];
+			return configuredChunkSize[STREAMER_TYPE_OBJECT];
 		}
 		case STREAMER_TYPE_MAP_ICON:
 		{
-			return chunkSize[STREAMER_TYPE_MAP_ICON];
+			return configuredChunkSize[STREAMER_TYPE_MAP_ICON];
 		}
 		case STREAMER_TYPE_3D_TEXT_LABEL:
 		{
-			return chunkSize[STREAMER_TYPE_3D_TEXT_LABEL];
+			return configuredChunkSize[STREAMER_TYPE_3D_TEXT_LABEL];
 		}
 	}
 	return 0;
@@ -56,16 +61,19 @@ bool ChunkStreamer::setChunkSize(int type, std::size_t value)
 			case STREAMER_TYPE_OBJECT:
 			{
 				chunkSize[STREAMER_TYPE_OBJECT] = value;
+				configuredChunkSize[STREAMER_TYPE_OBJECT] = value;
 				return true;
 			}
 			case STREAMER_TYPE_MAP_ICON:
 			{
 				chunkSize[STREAMER_TYPE_MAP_ICON] = value;
+				configuredChunkSize[STREAMER_TYPE_MAP_ICON] = value;
 				return true;
 			}
 			case STREAMER_TYPE_3D_TEXT_LABEL:
 			{
 				chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = value;
+				configuredChunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = value;
 				return true;
 			}
 		}
@@ -73,6 +81,47 @@ bool ChunkStreamer::setChunkSize(int type, std::size_t value)
 	return false;
 }
 
+void ChunkStreamer::setChunkTarget(float time, std::size_t minSize, std::size_t maxSize)
+{
+	chunkTargetTime = time;
+	chunkSizeLimits = std::make_tuple(minSize, maxSize);
+	if (chunkTargetTime <= 0.0f)
+	{
+		chunkSize[STREAMER_TYPE_OBJECT] = configuredChunkSize[STREAMER_TYPE_OBJECT];
+		chunkSize[STREAMER_TYPE_MAP_ICON] = configuredChunkSize[STREAMER_TYPE_MAP_ICON];
+		chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = configuredChunkSize[STREAMER_TYPE_3D_TEXT_LABEL];
+	}
+}
+
+void ChunkStreamer::adjustChunkSizes(float updateTime)
+{
+	if (chunkTargetTime <= 0.0f)
+	{
+		return;
+	}
+	std::size_t queuedItems[STREAMER_MAX_TYPES] = { 0 };
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		queuedItems[STREAMER_TYPE_OBJECT] += p->second.discoveredObjects.size() + p->second.removedObjects.size();
+		queuedItems[STREAMER_TYPE_MAP_ICON] += p->second.discoveredMapIcons.size() + p->second.removedMapIcons.size();
+		queuedItems[STREAMER_TYPE_3D_TEXT_LABEL] += p->second.discoveredTextLabels.size() + p->second.removedTextLabels.size();
+	}
+	const int types[] = { STREAMER_TYPE_OBJECT, STREAMER_TYPE_MAP_ICON, STREAMER_TYPE_3D_TEXT_LABEL };
+	for (std::size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i)
+	{
+		float size = static_cast<float>(chunkSize[types[i]]);
+		if (updateTime > chunkTargetTime)
+		{
+			size *= chunkTargetTime / updateTime;
+		}
+		else if (queuedItems[types[i]] > chunkSize[types[i]])
+		{
+			size += std::max(1.0f, size * 0.5f * ((chunkTargetTime - updateTime) / chunkTargetTime));
+		}
+		chunkSize[types[i]] = std::min(std::max(static_cast<std::size_t>(size + 0.5f), std::get<0>(chunkSizeLimits)), std::get<1>(chunkSizeLimits));
+	}
+}
+
 void ChunkStreamer::performPlayerChunkUpdate(Player &player, bool automatic)
 {
 	for (std::vector<int>::const_iterator t = core->getData()->typePriority.begin(); t != core->getData()->typePriority.end(); ++t)
@@ -107,9 +156,9 @@ void ChunkStreamer::performPlayerChunkUpdate(Player &player, bool automatic)
 	}
 }
 
-void ChunkStreamer::discoverMapIcons(Player &player, const std::vector<SharedCell> &cells)
+void ChunkStreamer::discoverMapIcons(Player &player, const std::vector<Cell*> &cells)
 {
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedMapIcon>::const_iterator m = (*c)->mapIcons.begin(); m != (*c)->mapIcons.end(); ++m)
 		{
@@ -258,54 +307,46 @@ void ChunkStreamer::streamMapIcons(Player &player, bool automatic)
 	}
 }
 
-void ChunkStreamer::discoverObjects(Player &player, const std::vector<SharedCell> &cells)
+void ChunkStreamer::discoverObject(Player &player, const Item::SharedObject &object)
 {
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	float distance = getObjectDistance(player, object);
+	std::unordered_map<int, int>::iterator i = player.internalObjects.find(object->objectId);
+	float comparableStreamDistance = getObjectStreamDistance(player, object, i != player.internalObjects.end());
+	if (i == player.internalObjects.end() ? distance < comparableStreamDistance : isWithinStreamOutRange(player.streamOutTimes[STREAMER_TYPE_OBJECT], object->objectId, distance, comparableStreamDistance, object->streamOutGrace))
 	{
-		for (std::unordered_map<int, Item::SharedObject>::const_iterator o = (*c)->objects.begin(); o != (*c)->objects.end(); ++o)
+		if (i == player.internalObjects.end())
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(o->second->players, player.playerId, o->second->interiors, player.interiorId, o->second->attach ? o->second->attach->worlds : o->second->worlds, player.worldId, o->second->areas, player.internalAreas, o->second->inverseAreaChecking))
-			{
-				if (o->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
-				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
-				}
-				else
-				{
-					if (o->second->attach)
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, o->second->attach->position)) + std::numeric_limits<float>::epsilon();
-					}
-					else
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(o->second->position + o->second->positionOffset)));
-					}
-				}
-			}
-			std::unordered_map<int, int>::iterator i = player.internalObjects.find(o->first);
-			if (distance < (o->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT]))
-			{
-				if (i == player.internalObjects.end())
-				{
-					player.discoveredObjects.insert(Item::Bimap<Item::SharedObject>::Type::value_type(std::make_tuple(o->second->priority, distance), std::make_tuple(o->first, o->second)));
-				}
-				else
-				{
-					if (o->second->cell)
-					{
-						player.visibleCell->objects.insert(*o);
-					}
-					player.existingObjects.insert(Item::Bimap<Item::SharedObject>::Type::value_type(std::make_tuple(o->second->priority, distance), std::make_tuple(o->first, o->second)));
-				}
-			}
-			else
+			player.discoveredObjects.insert(Item::Bimap<Item::SharedObject>::Type::value_type(std::make_tuple(object->priority, distance), std::make_tuple(object->objectId, object)));
+		}
+		else
+		{
+			if (object->cell)
 			{
-				if (i != player.internalObjects.end())
-				{
-					player.removedObjects.insert(i->first);
-				}
+				player.visibleCell->objects.insert(std::make_pair(object->objectId, object));
 			}
+			player.existingObjects.insert(Item::Bimap<Item::SharedObject>::Type::value_type(std::make_tuple(object->priority, distance), std::make_tuple(object->objectId, object)));
+		}
+	}
+	else
+	{
+		if (i != player.internalObjects.end())
+		{
+			player.removedObjects.insert(i->first);
+		}
+	}
+}
+
+void ChunkStreamer::discoverObjects(Player &player, const std::vector<Cell*> &cells)
+{
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	{
+		for (std::unordered_map<int, Item::SharedObject>::const_iterator o = (*c)->objects.begin(); o != (*c)->objects.end(); ++o)
+		{
+			discoverObject(player, o->second);
+		}
+		for (std::vector<Item::FrozenObject>::const_iterator o = (*c)->frozenObjects.begin(); o != (*c)->frozenObjects.end(); ++o)
+		{
+			discoverObject(player, o->object);
 		}
 	}
 	if (!player.discoveredObjects.empty() || !player.removedObjects.empty())
@@ -331,16 +372,11 @@ void ChunkStreamer::streamObjects(Player &player, bool automatic)
 				std::unordered_map<int, int>::iterator i = player.internalObjects.find(*r);
 				if (i != player.internalObjects.end())
 				{
-					sampgdk::DestroyPlayerObject(player.playerId, i->second);
 					std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(*r);
 					if (o != core->getData()->objects.end())
 					{
-						if (o->second->streamCallbacks)
-						{
-							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, *r, player.playerId));
-						}
+						destroyPlayerObject(player, o->second.get(), i);
 					}
-					player.internalObjects.erase(i);
 				}
 				r = player.removedObjects.erase(r);
 			}
@@ -385,12 +421,7 @@ void ChunkStreamer::streamObjects(Player &player, bool automatic)
 							std::unordered_map<int, int>::iterator j = player.internalObjects.find(std::get<0>(e->second));
 							if (j != player.internalObjects.end())
 							{
-								sampgdk::DestroyPlayerObject(player.playerId, j->second);
-								if (std::get<1>(e->second)->streamCallbacks)
-								{
-									streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, std::get<0>(e->second), player.playerId));
-								}
-								player.internalObjects.erase(j);
+								destroyPlayerObject(player, std::get<1>(e->second).get(), j);
 							}
 							if (std::get<1>(e->second)->cell)
 							{
@@ -406,63 +437,11 @@ void ChunkStreamer::streamObjects(Player &player, bool automatic)
 					streamingCanceled = true;
 					break;
 				}
-				int internalId = sampgdk::CreatePlayerObject(player.playerId, std::get<1>(d->second)->modelId, std::get<1>(d->second)->position[0], std::get<1>(d->second)->position[1], std::get<1>(d->second)->position[2], std::get<1>(d->second)->rotation[0], std::get<1>(d->second)->rotation[1], std::get<1>(d->second)->rotation[2], std::get<1>(d->second)->drawDistance);
-				if (internalId == INVALID_OBJECT_ID)
+				if (!createPlayerObject(player, std::get<1>(d->second).get(), internalBaseId))
 				{
 					streamingCanceled = true;
 					break;
 				}
-				if (std::get<1>(d->second)->streamCallbacks)
-				{
-					streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, std::get<0>(d->second), player.playerId));
-				}
-				if (std::get<1>(d->second)->attach)
-				{
-					if (internalBaseId != INVALID_STREAMER_ID)
-					{
-						static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
-						if (native != NULL)
-						{
-							sampgdk::InvokeNative(native, "dddffffffb", player.playerId, internalId, internalBaseId, std::get<1>(d->second)->attach->positionOffset[0], std::get<1>(d->second)->attach->positionOffset[1], std::get<1>(d->second)->attach->positionOffset[2], std::get<1>(d->second)->attach->rotation[0], std::get<1>(d->second)->attach->rotation[1], std::get<1>(d->second)->attach->rotation[2], std::get<1>(d->second)->attach->syncRotation);
-						}
-					}
-					else if (std::get<1>(d->second)->attach->player != INVALID_PLAYER_ID)
-					{
-						static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
-						if (native != NULL)
-						{
-							sampgdk::InvokeNative(native, "dddffffffd", player.playerId, internalId, std::get<1>(d->second)->attach->player, std::get<1>(d->second)->attach->positionOffset[0], std::get<1>(d->second)->attach->positionOffset[1], std::get<1>(d->second)->attach->positionOffset[2], std::get<1>(d->second)->attach->rotation[0], std::get<1>(d->second)->attach->rotation[1], std::get<1>(d->second)->attach->rotation[2], 1);
-						}
-					}
-					else if (std::get<1>(d->second)->attach->vehicle != INVALID_VEHICLE_ID)
-					{
-						sampgdk::AttachPlayerObjectToVehicle(player.playerId, internalId, std::get<1>(d->second)->attach->vehicle, std::get<1>(d->second)->attach->positionOffset[0], std::get<1>(d->second)->attach->positionOffset[1], std::get<1>(d->second)->attach->positionOffset[2], std::get<1>(d->second)->attach->rotation[0], std::get<1>(d->second)->attach->rotation[1], std::get<1>(d->second)->attach->rotation[2]);
-					}
-				}
-				else if (std::get<1>(d->second)->move)
-				{
-					sampgdk::MovePlayerObject(player.playerId, internalId, std::get<0>(std::get<1>(d->second)->move->position)[0], std::get<0>(std::get<1>(d->second)->move->position)[1], std::get<0>(std::get<1>(d->second)->move->position)[2], std::get<1>(d->second)->move->speed, std::get<0>(std::get<1>(d->second)->move->rotation)[0], std::get<0>(std::get<1>(d->second)->move->rotation)[1], std::get<0>(std::get<1>(d->second)->move->rotation)[2]);
-				}
-				for (std::unordered_map<int, Item::Object::Material>::iterator m = std::get<1>(d->second)->materials.begin(); m != std::get<1>(d->second)->materials.end(); ++m)
-				{
-					if (m->second.main)
-					{
-						sampgdk::SetPlayerObjectMaterial(player.playerId, internalId, m->first, m->second.main->modelId, m->second.main->txdFileName.c_str(), m->second.main->textureName.c_str(), m->second.main->materialColor);
-					}
-					else if (m->second.text)
-					{
-						sampgdk::SetPlayerObjectMaterialText(player.playerId, internalId, m->second.text->materialText.c_str(), m->first, m->second.text->materialSize, m->second.text->fontFace.c_str(), m->second.text->fontSize, m->second.text->bold, m->second.text->fontColor, m->second.text->backColor, m->second.text->textAlignment);
-					}
-				}
-				if (std::get<1>(d->second)->noCameraCollision)
-				{
-					sampgdk::SetPlayerObjectNoCameraCol(player.playerId, internalId);
-				}
-				player.internalObjects.insert(std::make_pair(std::get<0>(d->second), internalId));
-				if (std::get<1>(d->second)->cell)
-				{
-					player.visibleCell->objects.insert(std::make_pair(std::get<0>(d->second), std::get<1>(d->second)));
-				}
 				d = player.discoveredObjects.left.erase(d);
 			}
 			if (streamingCanceled)
@@ -480,9 +459,9 @@ void ChunkStreamer::streamObjects(Player &player, bool automatic)
 	}
 }
 
-void ChunkStreamer::discoverTextLabels(Player &player, const std::vector<SharedCell> &cells)
+void ChunkStreamer::discoverTextLabels(Player &player, const std::vector<Cell*> &cells)
 {
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedTextLabel>::const_iterator t = (*c)->textLabels.begin(); t != (*c)->textLabels.end(); ++t)
 		{
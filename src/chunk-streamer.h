@@ -38,11 +38,20 @@ public:
 		chunkStreamingEnabled = enabled;
 	}
 
+	inline std::tuple<float, std::size_t, std::size_t> getChunkTarget()
+	{
+		return std::make_tuple(chunkTargetTime, std::get<0>(chunkSizeLimits), std::get<1>(chunkSizeLimits));
+	}
+
+	void setChunkTarget(float time, std::size_t minSize, std::size_t maxSize);
+
+	void adjustChunkSizes(float updateTime);
 	void performPlayerChunkUpdate(Player &player, bool automatic);
 
-	void discoverMapIcons(Player &player, const std::vector<SharedCell> &cells);
-	void discoverObjects(Player &player, const std::vector<SharedCell> &cells);
-	void discoverTextLabels(Player &player, const std::vector<SharedCell> &cells);
+	void discoverMapIcons(Player &player, const std::vector<Cell*> &cells);
+	void discoverObject(Player &player, const Item::SharedObject &object);
+	void discoverObjects(Player &player, const std::vector<Cell*> &cells);
+	void discoverTextLabels(Player &player, const std::vector<Cell*> &cells);
 
 	std::size_t getChunkSize(int type);
 	bool setChunkSize(int type, std::size_t value);
@@ -52,7 +61,10 @@ private:
 	void streamTextLabels(Player &player, bool automatic);
 
 	std::size_t chunkSize[STREAMER_MAX_TYPES];
+	std::size_t configuredChunkSize[STREAMER_MAX_TYPES];
+	std::tuple<std::size_t, std::size_t> chunkSizeLimits;
 	bool chunkStreamingEnabled;
+	float chunkTargetTime;
 };
 
 #endif
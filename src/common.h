@@ -48,6 +48,21 @@
 
 #define STREAMER_STATIC_DISTANCE_CUTOFF (0.0f)
 
+#define STREAMER_MAX_DENSE_GRID_WIDTH (1024)
+#define STREAMER_MAX_GRID_LEVELS (8)
+#define STREAMER_MAX_DIRTY_ITEMS (4096)
+#define STREAMER_MAX_WORKER_THREADS (64)
+
+// Estimated RPC payload sizes in bytes, used by the per-player byte budget
+#define STREAMER_COST_MAP_ICON (24) // SetPlayerMapIcon
+#define STREAMER_COST_OBJECT (48) // CreateObject
+#define STREAMER_COST_OBJECT_ATTACH (40) // AttachObjectToObject/Player/Vehicle
+#define STREAMER_COST_OBJECT_MOVE (48) // MoveObject
+#define STREAMER_COST_OBJECT_NO_CAMERA_COL (8) // SetObjectNoCameraCol
+#define STREAMER_COST_OBJECT_MATERIAL (20) // SetObjectMaterial, plus the TXD and texture names
+#define STREAMER_COST_OBJECT_MATERIAL_TEXT (28) // SetObjectMaterialText, plus the font and text
+#define STREAMER_COST_3D_TEXT_LABEL (36) // Create3DTextLabel, plus the text
+
 class Cell;
 class Data;
 class Events;
@@ -57,6 +72,7 @@ struct Player;
 class Streamer;
 
 typedef std::pair<int, int> CellId;
+typedef std::pair<int, int> PartitionId;
 typedef std::shared_ptr<Cell> SharedCell;
 
 typedef boost::geometry::model::box<Eigen::Vector2f> Box2d;
@@ -68,6 +84,7 @@ namespace Item
 	struct Actor;
 	struct Area;
 	struct Checkpoint;
+	struct FrozenObject;
 	struct MapIcon;
 	struct Object;
 	struct Pickup;
@@ -107,6 +124,42 @@ namespace Item
 		}
 	};
 
+	template<typename T>
+	struct BestFirstCompare
+	{
+		bool operator()(std::pair<std::pair<int, float>, T> const &a, std::pair<std::pair<int, float>, T> const &b) const
+		{
+			return PairCompare()(b.first, a.first);
+		}
+	};
+
+	template<typename T>
+	struct WorstFirstCompare
+	{
+		bool operator()(std::pair<std::pair<int, float>, T> const &a, std::pair<std::pair<int, float>, T> const &b) const
+		{
+			return PairCompare()(a.first, b.first);
+		}
+	};
+
+	template<typename T>
+	struct HighestPriorityFirstCompare
+	{
+		bool operator()(std::pair<int, T> const &a, std::pair<int, T> const &b) const
+		{
+			return a.first < b.first;
+		}
+	};
+
+	template<typename T>
+	struct LowestPriorityFirstCompare
+	{
+		bool operator()(std::pair<int, T> const &a, std::pair<int, T> const &b) const
+		{
+			return a.first > b.first;
+		}
+	};
+
 	template<typename T>
 	struct LeftTupleCompare
 	{
@@ -178,10 +231,10 @@ struct pair_hash
 	template <class T1, class T2>
 	std::size_t operator () (std::pair<T1, T2> const& pair) const
 	{
-		std::size_t h1 = std::hash<T1>()(pair.first);
-		std::size_t h2 = std::hash<T2>()(pair.second);
-
-		return h1 ^ h2;
+		std::size_t seed = 0;
+		boost::hash_combine(seed, pair.first);
+		boost::hash_combine(seed, pair.second);
+		return seed;
 	}
 };
 
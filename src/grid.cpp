@@ -23,28 +23,51 @@ Grid::Grid()
 {
 	cellDistance = 360000.0f;
 	cellSize = 300.0f;
+	requestedCellSize = 300.0f;
+	denseGridEnabled = false;
+	denseGridExtent = 20000.0f;
+	incrementalRebuildEnabled = false;
+	zBandingEnabled = false;
+	zBandHeight = 50.0f;
+	incrementalRebuildItems = 10000;
+	incrementalRebuildIndex = 0;
+	incrementalRebuildType = 0;
+	cells.resize(STREAMER_MAX_GRID_LEVELS);
+	levelStreamDistances.assign(STREAMER_MAX_GRID_LEVELS, -1.0f);
 	globalCell = std::make_shared<Cell>();
-	calculateTranslationMatrix();
+	version = 1;
+	calculateDenseGrid();
 }
 
 void Grid::addActor(const Item::SharedActor &actor)
 {
-	if (actor->comparableStreamDistance > cellDistance || actor->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_ACTOR, actor->actorId));
+	}
+	int level = getCellLevel(actor->comparableStreamDistance);
+	if (level < 0 || actor->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->actors.insert(std::make_pair(actor->actorId, actor));
 		actor->cell.reset();
 	}
 	else
 	{
-		CellId cellId = getCellId(Eigen::Vector2f(actor->position[0], actor->position[1]));
-		cells[cellId]->actors.insert(std::make_pair(actor->actorId, actor));
-		actor->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(actor->position[0], actor->position[1]), level), getPartitionId(actor), core->getStreamer()->getComparableStreamOutDistance(actor->comparableStreamDistance, actor->streamOutMargin), Eigen::Vector2f::Constant(actor->position[2] + actor->positionOffset[2]));
+		cell->actors.insert(std::make_pair(actor->actorId, actor));
+		actor->cell = cell;
 	}
 }
 
 void Grid::addArea(const Item::SharedArea &area)
 {
-	if (area->comparableSize > cellDistance)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_AREA, area->areaId));
+	}
+	indexArea(area);
+	int level = getCellLevel(area->comparableSize);
+	if (level < 0)
 	{
 		globalCell->areas.insert(std::make_pair(area->areaId, area));
 		area->cell.reset();
@@ -52,6 +75,7 @@ void Grid::addArea(const Item::SharedArea &area)
 	else
 	{
 		Eigen::Vector2f centroid = Eigen::Vector2f::Zero();
+		Eigen::Vector2f height(-std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity());
 		std::variant<Polygon2d, Box2d, Box3d, Eigen::Vector2f, Eigen::Vector3f> position;
 		if (area->attach)
 		{
@@ -67,11 +91,16 @@ void Grid::addArea(const Item::SharedArea &area)
 			case STREAMER_AREA_TYPE_CYLINDER:
 			{
 				centroid = Eigen::Vector2f(std::get<Eigen::Vector2f>(position));
+				if (area->type == STREAMER_AREA_TYPE_CYLINDER)
+				{
+					height = area->attach ? area->attach->height : area->height;
+				}
 				break;
 			}
 			case STREAMER_AREA_TYPE_SPHERE:
 			{
 				centroid = Eigen::Vector2f(std::get<Eigen::Vector3f>(position)[0], std::get<Eigen::Vector3f>(position)[1]);
+				height = Eigen::Vector2f::Constant(std::get<Eigen::Vector3f>(position)[2]);
 				break;
 			}
 			case STREAMER_AREA_TYPE_RECTANGLE:
@@ -83,133 +112,217 @@ void Grid::addArea(const Item::SharedArea &area)
 			{
 				Eigen::Vector3f point = boost::geometry::return_centroid<Eigen::Vector3f>(std::get<Box3d>(position));
 				centroid = Eigen::Vector2f(point[0], point[1]);
+				height = Eigen::Vector2f(std::get<Box3d>(position).min_corner()[2], std::get<Box3d>(position).max_corner()[2]);
 				break;
 			}
 			case STREAMER_AREA_TYPE_POLYGON:
 			{
 				boost::geometry::centroid(std::get<Polygon2d>(position), centroid);
+				height = area->attach ? area->attach->height : area->height;
 				break;
 			}
 		}
-		CellId cellId = getCellId(centroid);
-		cells[cellId]->areas.insert(std::make_pair(area->areaId, area));
-		area->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(centroid, level), area->attach ? std::make_pair(-1, -1) : getPartitionId(area), area->comparableSize, height);
+		cell->areas.insert(std::make_pair(area->areaId, area));
+		area->cell = cell;
 	}
 }
 
 void Grid::addCheckpoint(const Item::SharedCheckpoint &checkpoint)
 {
-	if (checkpoint->comparableStreamDistance > cellDistance || checkpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_CP, checkpoint->checkpointId));
+	}
+	int level = getCellLevel(checkpoint->comparableStreamDistance);
+	if (level < 0 || checkpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->checkpoints.insert(std::make_pair(checkpoint->checkpointId, checkpoint));
 		checkpoint->cell.reset();
 	}
 	else
 	{
-		CellId cellId = getCellId(Eigen::Vector2f(checkpoint->position[0], checkpoint->position[1]));
-		cells[cellId]->checkpoints.insert(std::make_pair(checkpoint->checkpointId, checkpoint));
-		checkpoint->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(checkpoint->position[0], checkpoint->position[1]), level), getPartitionId(checkpoint), checkpoint->comparableStreamDistance, Eigen::Vector2f::Constant(checkpoint->position[2] + checkpoint->positionOffset[2]));
+		cell->checkpoints.insert(std::make_pair(checkpoint->checkpointId, checkpoint));
+		checkpoint->cell = cell;
 	}
 }
 
 void Grid::addMapIcon(const Item::SharedMapIcon &mapIcon)
 {
-	if (mapIcon->comparableStreamDistance > cellDistance || mapIcon->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_MAP_ICON, mapIcon->mapIconId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_MAP_ICON, mapIcon->mapIconId);
+	}
+	int level = getCellLevel(mapIcon->comparableStreamDistance);
+	if (level < 0 || mapIcon->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->mapIcons.insert(std::make_pair(mapIcon->mapIconId, mapIcon));
 		mapIcon->cell.reset();
 	}
 	else
 	{
-		CellId cellId = getCellId(Eigen::Vector2f(mapIcon->position[0], mapIcon->position[1]));
-		cells[cellId]->mapIcons.insert(std::make_pair(mapIcon->mapIconId, mapIcon));
-		mapIcon->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(mapIcon->position[0], mapIcon->position[1]), level), getPartitionId(mapIcon), mapIcon->comparableStreamDistance, Eigen::Vector2f::Constant(mapIcon->position[2] + mapIcon->positionOffset[2]));
+		cell->mapIcons.insert(std::make_pair(mapIcon->mapIconId, mapIcon));
+		mapIcon->cell = cell;
 	}
 }
 
 void Grid::addObject(const Item::SharedObject &object)
 {
-	if (object->comparableStreamDistance > cellDistance || object->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_OBJECT, object->objectId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, object->objectId);
+	}
+	int level = getCellLevel(object->comparableStreamDistance);
+	if (level < 0 || object->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->objects.insert(std::make_pair(object->objectId, object));
 		object->cell.reset();
 	}
 	else
 	{
-		Eigen::Vector2f position = Eigen::Vector2f::Zero();
+		Eigen::Vector3f position = Eigen::Vector3f::Zero();
+		Eigen::Vector2f height = Eigen::Vector2f::Zero();
 		if (object->attach)
 		{
-			position = Eigen::Vector2f(object->attach->position[0], object->attach->position[1]);
+			position = object->attach->position;
+			height = Eigen::Vector2f::Constant(position[2]);
 		}
 		else
 		{
-			position = Eigen::Vector2f(object->position[0], object->position[1]);
+			position = object->position;
+			height = Eigen::Vector2f::Constant(position[2] + object->positionOffset[2]);
 		}
-		CellId cellId = getCellId(Eigen::Vector2f(position[0], position[1]));
-		cells[cellId]->objects.insert(std::make_pair(object->objectId, object));
-		object->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(position[0], position[1]), level), object->attach ? std::make_pair(-1, -1) : getPartitionId(object), object->comparableStreamDistance, height);
+		cell->objects.insert(std::make_pair(object->objectId, object));
+		object->cell = cell;
 	}
 }
 
 void Grid::addPickup(const Item::SharedPickup &pickup)
 {
-	if (pickup->comparableStreamDistance > cellDistance || pickup->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_PICKUP, pickup->pickupId));
+	}
+	int level = getCellLevel(pickup->comparableStreamDistance);
+	if (level < 0 || pickup->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->pickups.insert(std::make_pair(pickup->pickupId, pickup));
 		pickup->cell.reset();
 	}
 	else
 	{
-		CellId cellId = getCellId(Eigen::Vector2f(pickup->position[0], pickup->position[1]));
-		cells[cellId]->pickups.insert(std::make_pair(pickup->pickupId, pickup));
-		pickup->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(pickup->position[0], pickup->position[1]), level), getPartitionId(pickup), pickup->comparableStreamDistance, Eigen::Vector2f::Constant(pickup->position[2] + pickup->positionOffset[2]));
+		cell->pickups.insert(std::make_pair(pickup->pickupId, pickup));
+		pickup->cell = cell;
 	}
 }
 
 void Grid::addRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint)
 {
-	if (raceCheckpoint->comparableStreamDistance > cellDistance || raceCheckpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_RACE_CP, raceCheckpoint->raceCheckpointId));
+	}
+	int level = getCellLevel(raceCheckpoint->comparableStreamDistance);
+	if (level < 0 || raceCheckpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointId, raceCheckpoint));
 		raceCheckpoint->cell.reset();
 	}
 	else
 	{
-		CellId cellId = getCellId(Eigen::Vector2f(raceCheckpoint->position[0], raceCheckpoint->position[1]));
-		cells[cellId]->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointId, raceCheckpoint));
-		raceCheckpoint->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(raceCheckpoint->position[0], raceCheckpoint->position[1]), level), getPartitionId(raceCheckpoint), raceCheckpoint->comparableStreamDistance, Eigen::Vector2f::Constant(raceCheckpoint->position[2] + raceCheckpoint->positionOffset[2]));
+		cell->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointId, raceCheckpoint));
+		raceCheckpoint->cell = cell;
 	}
 }
 
 void Grid::addTextLabel(const Item::SharedTextLabel &textLabel)
 {
-	if (textLabel->comparableStreamDistance > cellDistance || textLabel->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_3D_TEXT_LABEL, textLabel->textLabelId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_3D_TEXT_LABEL, textLabel->textLabelId);
+	}
+	int level = getCellLevel(textLabel->comparableStreamDistance);
+	if (level < 0 || textLabel->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 	{
 		globalCell->textLabels.insert(std::make_pair(textLabel->textLabelId, textLabel));
 		textLabel->cell.reset();
 	}
 	else
 	{
-		Eigen::Vector2f position = Eigen::Vector2f::Zero();
+		Eigen::Vector3f position = Eigen::Vector3f::Zero();
+		Eigen::Vector2f height = Eigen::Vector2f::Zero();
 		if (textLabel->attach)
 		{
-			position = Eigen::Vector2f(textLabel->attach->position[0], textLabel->attach->position[1]);
+			position = textLabel->attach->position;
+			height = Eigen::Vector2f::Constant(position[2]);
 		}
 		else
 		{
-			position = Eigen::Vector2f(textLabel->position[0], textLabel->position[1]);;
+			position = textLabel->position;
+			height = Eigen::Vector2f::Constant(position[2] + textLabel->positionOffset[2]);
 		}
-		CellId cellId = getCellId(position);
-		cells[cellId]->textLabels.insert(std::make_pair(textLabel->textLabelId, textLabel));
-		textLabel->cell = cells[cellId];
+		SharedCell &cell = insertCell(level, getCellId(Eigen::Vector2f(position[0], position[1]), level), textLabel->attach ? std::make_pair(-1, -1) : getPartitionId(textLabel), textLabel->comparableStreamDistance, height);
+		cell->textLabels.insert(std::make_pair(textLabel->textLabelId, textLabel));
+		textLabel->cell = cell;
 	}
 }
 
 void Grid::rebuildGrid()
 {
-	cells.clear();
-	globalCell = std::make_shared<Cell>();
-	calculateTranslationMatrix();
+	if (incrementalRebuildEnabled)
+	{
+		nextGrid.reset(new Grid());
+		nextGrid->setCellDistance(cellDistance);
+		nextGrid->setDenseGrid(denseGridEnabled, denseGridExtent);
+		nextGrid->setZBanding(zBandingEnabled, zBandHeight);
+		nextGrid->cellSize = requestedCellSize;
+		nextGrid->requestedCellSize = requestedCellSize;
+		nextGrid->calculateDenseGrid();
+		rebuildChangedItems.clear();
+		incrementalRebuildIndex = 0;
+		incrementalRebuildType = 0;
+		snapshotItems(core->getData()->objects, rebuildObjects);
+		snapshotItems(core->getData()->pickups, rebuildPickups);
+		snapshotItems(core->getData()->checkpoints, rebuildCheckpoints);
+		snapshotItems(core->getData()->raceCheckpoints, rebuildRaceCheckpoints);
+		snapshotItems(core->getData()->mapIcons, rebuildMapIcons);
+		snapshotItems(core->getData()->textLabels, rebuildTextLabels);
+		snapshotItems(core->getData()->areas, rebuildAreas);
+		snapshotItems(core->getData()->actors, rebuildActors);
+		return;
+	}
+	if (nextGrid)
+	{
+		nextGrid.reset();
+		rebuildChangedItems.clear();
+		rebuildObjects.clear();
+		rebuildPickups.clear();
+		rebuildCheckpoints.clear();
+		rebuildRaceCheckpoints.clear();
+		rebuildMapIcons.clear();
+		rebuildTextLabels.clear();
+		rebuildAreas.clear();
+		rebuildActors.clear();
+	}
+	cellSize = requestedCellSize;
+	clearGrid();
 
 	for (std::unordered_map<int, Item::SharedActor>::iterator a = core->getData()->actors.begin(); a != core->getData()->actors.end(); ++a)
 	{
@@ -245,19 +358,202 @@ void Grid::rebuildGrid()
 	}
 }
 
+void Grid::processIncrementalRebuild()
+{
+	if (!nextGrid)
+	{
+		return;
+	}
+	std::size_t remaining = incrementalRebuildItems;
+	while (incrementalRebuildType < STREAMER_MAX_TYPES)
+	{
+		bool finished = true;
+		switch (incrementalRebuildType)
+		{
+			case STREAMER_TYPE_OBJECT:
+			{
+				finished = placeItems(rebuildObjects, &Grid::addObject, remaining);
+				break;
+			}
+			case STREAMER_TYPE_PICKUP:
+			{
+				finished = placeItems(rebuildPickups, &Grid::addPickup, remaining);
+				break;
+			}
+			case STREAMER_TYPE_CP:
+			{
+				finished = placeItems(rebuildCheckpoints, &Grid::addCheckpoint, remaining);
+				break;
+			}
+			case STREAMER_TYPE_RACE_CP:
+			{
+				finished = placeItems(rebuildRaceCheckpoints, &Grid::addRaceCheckpoint, remaining);
+				break;
+			}
+			case STREAMER_TYPE_MAP_ICON:
+			{
+				finished = placeItems(rebuildMapIcons, &Grid::addMapIcon, remaining);
+				break;
+			}
+			case STREAMER_TYPE_3D_TEXT_LABEL:
+			{
+				finished = placeItems(rebuildTextLabels, &Grid::addTextLabel, remaining);
+				break;
+			}
+			case STREAMER_TYPE_AREA:
+			{
+				finished = placeItems(rebuildAreas, &Grid::addArea, remaining);
+				break;
+			}
+			case STREAMER_TYPE_ACTOR:
+			{
+				finished = placeItems(rebuildActors, &Grid::addActor, remaining);
+				break;
+			}
+		}
+		if (!finished)
+		{
+			return;
+		}
+		incrementalRebuildIndex = 0;
+		++incrementalRebuildType;
+	}
+	finishIncrementalRebuild();
+}
+
+std::size_t Grid::freezeStaticLayer()
+{
+	std::size_t frozenObjects = freezeCell(globalCell);
+	for (std::size_t i = 0; i < denseCells.size(); ++i)
+	{
+		if (denseCells[i])
+		{
+			frozenObjects += freezeCell(denseCells[i]);
+		}
+	}
+	for (std::vector<CellMap>::iterator l = cells.begin(); l != cells.end(); ++l)
+	{
+		for (CellMap::iterator c = l->begin(); c != l->end(); ++c)
+		{
+			frozenObjects += freezeCell(*c);
+		}
+	}
+	return frozenObjects;
+}
+
+std::size_t Grid::freezeCell(const SharedCell &cell)
+{
+	std::size_t frozenObjects = 0;
+	std::unordered_map<int, Item::SharedObject>::iterator o = cell->objects.begin();
+	while (o != cell->objects.end())
+	{
+		if (!o->second->attach && !o->second->move)
+		{
+			cell->frozenObjects.push_back(Item::FrozenObject(o->second));
+			o = cell->objects.erase(o);
+			++frozenObjects;
+		}
+		else
+		{
+			++o;
+		}
+	}
+	if (frozenObjects)
+	{
+		std::sort(cell->frozenObjects.begin(), cell->frozenObjects.end(), Item::FrozenObjectCompare());
+		cell->frozenObjects.shrink_to_fit();
+	}
+	for (std::unordered_map<PartitionId, SharedCell, pair_hash>::iterator p = cell->partitions.begin(); p != cell->partitions.end(); ++p)
+	{
+		frozenObjects += freezeCell(p->second);
+	}
+	return frozenObjects;
+}
+
+bool Grid::eraseFrozenObject(const SharedCell &cell, int objectId)
+{
+	std::vector<Item::FrozenObject>::iterator o = std::lower_bound(cell->frozenObjects.begin(), cell->frozenObjects.end(), objectId, Item::FrozenObjectCompare());
+	if (o != cell->frozenObjects.end() && o->objectId == objectId)
+	{
+		cell->frozenObjects.erase(o);
+		return true;
+	}
+	return false;
+}
+
+void Grid::thawObject(int objectId)
+{
+	std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(objectId);
+	if (o != core->getData()->objects.end())
+	{
+		SharedCell c = globalCell;
+		if (o->second->cell)
+		{
+			c = findCell(o->second->cell->level, o->second->cell->cellId, o->second->cell->partitionId);
+		}
+		if (c && eraseFrozenObject(c, objectId))
+		{
+			c->objects.insert(*o);
+		}
+	}
+}
+
+void Grid::clearGrid()
+{
+	cells.clear();
+	cells.resize(STREAMER_MAX_GRID_LEVELS);
+	levelStreamDistances.assign(STREAMER_MAX_GRID_LEVELS, -1.0f);
+	globalCell = std::make_shared<Cell>();
+	areaTree.clear();
+	areaBoxes.clear();
+	++version;
+	calculateDenseGrid();
+}
+
+void Grid::finishIncrementalRebuild()
+{
+	std::swap(cellSize, nextGrid->cellSize);
+	std::swap(cells, nextGrid->cells);
+	std::swap(denseCells, nextGrid->denseCells);
+	std::swap(denseGridOffset, nextGrid->denseGridOffset);
+	std::swap(denseGridWidth, nextGrid->denseGridWidth);
+	std::swap(globalCell, nextGrid->globalCell);
+	std::swap(levelStreamDistances, nextGrid->levelStreamDistances);
+	++version;
+	applyPlacements(rebuildObjects, core->getData()->objects, &Cell::objects, &Item::Object::objectId, STREAMER_TYPE_OBJECT);
+	applyPlacements(rebuildPickups, core->getData()->pickups, &Cell::pickups, &Item::Pickup::pickupId, STREAMER_TYPE_PICKUP);
+	applyPlacements(rebuildCheckpoints, core->getData()->checkpoints, &Cell::checkpoints, &Item::Checkpoint::checkpointId, STREAMER_TYPE_CP);
+	applyPlacements(rebuildRaceCheckpoints, core->getData()->raceCheckpoints, &Cell::raceCheckpoints, &Item::RaceCheckpoint::raceCheckpointId, STREAMER_TYPE_RACE_CP);
+	applyPlacements(rebuildMapIcons, core->getData()->mapIcons, &Cell::mapIcons, &Item::MapIcon::mapIconId, STREAMER_TYPE_MAP_ICON);
+	applyPlacements(rebuildTextLabels, core->getData()->textLabels, &Cell::textLabels, &Item::TextLabel::textLabelId, STREAMER_TYPE_3D_TEXT_LABEL);
+	applyPlacements(rebuildAreas, core->getData()->areas, &Cell::areas, &Item::Area::areaId, STREAMER_TYPE_AREA);
+	applyPlacements(rebuildActors, core->getData()->actors, &Cell::actors, &Item::Actor::actorId, STREAMER_TYPE_ACTOR);
+	nextGrid.reset();
+	std::unordered_set<std::pair<int, int>, pair_hash> changedItems;
+	changedItems.swap(rebuildChangedItems);
+	for (std::unordered_set<std::pair<int, int>, pair_hash>::iterator i = changedItems.begin(); i != changedItems.end(); ++i)
+	{
+		reassignItem(i->first, i->second);
+	}
+}
+
 void Grid::removeActor(const Item::SharedActor &actor, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_ACTOR, actor->actorId));
+	}
 	bool found = false;
+	SharedCell c;
 	if (actor->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(actor->cell->cellId);
-		if (c != cells.end())
+		c = findCell(actor->cell->level, actor->cell->cellId, actor->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedActor>::iterator a = c->second->actors.find(actor->actorId);
-			if (a != c->second->actors.end())
+			std::unordered_map<int, Item::SharedActor>::iterator a = c->actors.find(actor->actorId);
+			if (a != c->actors.end())
 			{
-				c->second->actors.erase(a);
-				eraseCellIfEmpty(c->second);
+				c->actors.erase(a);
 				found = true;
 			}
 		}
@@ -271,28 +567,37 @@ void Grid::removeActor(const Item::SharedActor &actor, bool reassign)
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
 			addActor(actor);
 		}
+		if (c && (!reassign || actor->cell != c))
+		{
+			eraseCellIfEmpty(c);
+		}
 	}
 }
 
 void Grid::removeArea(const Item::SharedArea &area, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_AREA, area->areaId));
+	}
+	unindexArea(area->areaId);
 	bool found = false;
+	SharedCell c;
 	if (area->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(area->cell->cellId);
-		if (c != cells.end())
+		c = findCell(area->cell->level, area->cell->cellId, area->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedArea>::iterator a = c->second->areas.find(area->areaId);
-			if (a != c->second->areas.end())
+			std::unordered_map<int, Item::SharedArea>::iterator a = c->areas.find(area->areaId);
+			if (a != c->areas.end())
 			{
-				c->second->areas.erase(a);
-				eraseCellIfEmpty(c->second);
+				c->areas.erase(a);
 				found = true;
 			}
 		}
@@ -306,7 +611,7 @@ void Grid::removeArea(const Item::SharedArea &area, bool reassign)
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
@@ -319,22 +624,37 @@ void Grid::removeArea(const Item::SharedArea &area, bool reassign)
 				core->getStreamer()->attachedAreas.erase(area);
 			}
 		}
+		if (!reassign || area->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(area, area->areaId, &Cell::areas);
+			}
+		}
 	}
 }
 
 void Grid::removeCheckpoint(const Item::SharedCheckpoint &checkpoint, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_CP, checkpoint->checkpointId));
+	}
 	bool found = false;
+	SharedCell c;
 	if (checkpoint->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(checkpoint->cell->cellId);
-		if (c != cells.end())
+		c = findCell(checkpoint->cell->level, checkpoint->cell->cellId, checkpoint->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedCheckpoint>::iterator d = c->second->checkpoints.find(checkpoint->checkpointId);
-			if (d != c->second->checkpoints.end())
+			std::unordered_map<int, Item::SharedCheckpoint>::iterator d = c->checkpoints.find(checkpoint->checkpointId);
+			if (d != c->checkpoints.end())
 			{
-				c->second->checkpoints.erase(d);
-				eraseCellIfEmpty(c->second);
+				c->checkpoints.erase(d);
 				found = true;
 			}
 		}
@@ -348,28 +668,47 @@ void Grid::removeCheckpoint(const Item::SharedCheckpoint &checkpoint, bool reass
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
 			addCheckpoint(checkpoint);
 		}
+		if (!reassign || checkpoint->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(checkpoint, checkpoint->checkpointId, &Cell::checkpoints);
+			}
+		}
 	}
 }
 
 void Grid::removeMapIcon(const Item::SharedMapIcon &mapIcon, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_MAP_ICON, mapIcon->mapIconId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_MAP_ICON, mapIcon->mapIconId);
+	}
 	bool found = false;
+	SharedCell c;
 	if (mapIcon->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(mapIcon->cell->cellId);
-		if (c != cells.end())
+		c = findCell(mapIcon->cell->level, mapIcon->cell->cellId, mapIcon->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedMapIcon>::iterator m = c->second->mapIcons.find(mapIcon->mapIconId);
-			if (m != c->second->mapIcons.end())
+			std::unordered_map<int, Item::SharedMapIcon>::iterator m = c->mapIcons.find(mapIcon->mapIconId);
+			if (m != c->mapIcons.end())
 			{
-				c->second->mapIcons.erase(m);
-				eraseCellIfEmpty(c->second);
+				c->mapIcons.erase(m);
 				found = true;
 			}
 		}
@@ -383,30 +722,53 @@ void Grid::removeMapIcon(const Item::SharedMapIcon &mapIcon, bool reassign)
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
 			addMapIcon(mapIcon);
 		}
+		if (!reassign || mapIcon->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(mapIcon, mapIcon->mapIconId, &Cell::mapIcons);
+			}
+		}
 	}
 }
 
 void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_OBJECT, object->objectId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, object->objectId);
+	}
 	bool found = false;
+	SharedCell c;
 	if (object->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(object->cell->cellId);
-		if (c != cells.end())
+		c = findCell(object->cell->level, object->cell->cellId, object->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedObject>::iterator o = c->second->objects.find(object->objectId);
-			if (o != c->second->objects.end())
+			std::unordered_map<int, Item::SharedObject>::iterator o = c->objects.find(object->objectId);
+			if (o != c->objects.end())
 			{
-				c->second->objects.erase(o);
-				eraseCellIfEmpty(c->second);
+				c->objects.erase(o);
 				found = true;
 			}
+			else
+			{
+				found = eraseFrozenObject(c, object->objectId);
+			}
 		}
 	}
 	else
@@ -417,8 +779,12 @@ void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 			globalCell->objects.erase(o);
 			found = true;
 		}
+		else
+		{
+			found = eraseFrozenObject(globalCell, object->objectId);
+		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
@@ -435,22 +801,37 @@ void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 				core->getStreamer()->movingObjects.erase(object);
 			}
 		}
+		if (!reassign || object->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(object, object->objectId, &Cell::objects);
+			}
+		}
 	}
 }
 
 void Grid::removePickup(const Item::SharedPickup &pickup, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_PICKUP, pickup->pickupId));
+	}
 	bool found = false;
+	SharedCell c;
 	if (pickup->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(pickup->cell->cellId);
-		if (c != cells.end())
+		c = findCell(pickup->cell->level, pickup->cell->cellId, pickup->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedPickup>::iterator p = c->second->pickups.find(pickup->pickupId);
-			if (p != c->second->pickups.end())
+			std::unordered_map<int, Item::SharedPickup>::iterator p = c->pickups.find(pickup->pickupId);
+			if (p != c->pickups.end())
 			{
-				c->second->pickups.erase(p);
-				eraseCellIfEmpty(c->second);
+				c->pickups.erase(p);
 				found = true;
 			}
 		}
@@ -464,28 +845,36 @@ void Grid::removePickup(const Item::SharedPickup &pickup, bool reassign)
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
 			addPickup(pickup);
 		}
+		if (c && (!reassign || pickup->cell != c))
+		{
+			eraseCellIfEmpty(c);
+		}
 	}
 }
 
 void Grid::removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_RACE_CP, raceCheckpoint->raceCheckpointId));
+	}
 	bool found = false;
+	SharedCell c;
 	if (raceCheckpoint->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(raceCheckpoint->cell->cellId);
-		if (c != cells.end())
+		c = findCell(raceCheckpoint->cell->level, raceCheckpoint->cell->cellId, raceCheckpoint->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = c->second->raceCheckpoints.find(raceCheckpoint->raceCheckpointId);
-			if (r != c->second->raceCheckpoints.end())
+			std::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = c->raceCheckpoints.find(raceCheckpoint->raceCheckpointId);
+			if (r != c->raceCheckpoints.end())
 			{
-				c->second->raceCheckpoints.erase(r);
-				eraseCellIfEmpty(c->second);
+				c->raceCheckpoints.erase(r);
 				found = true;
 			}
 		}
@@ -499,28 +888,47 @@ void Grid::removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
 			addRaceCheckpoint(raceCheckpoint);
 		}
+		if (!reassign || raceCheckpoint->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(raceCheckpoint, raceCheckpoint->raceCheckpointId, &Cell::raceCheckpoints);
+			}
+		}
 	}
 }
 
 void Grid::removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign)
 {
+	if (nextGrid)
+	{
+		rebuildChangedItems.insert(std::make_pair(STREAMER_TYPE_3D_TEXT_LABEL, textLabel->textLabelId));
+	}
+	if (core->getGrid() == this)
+	{
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_3D_TEXT_LABEL, textLabel->textLabelId);
+	}
 	bool found = false;
+	SharedCell c;
 	if (textLabel->cell)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(textLabel->cell->cellId);
-		if (c != cells.end())
+		c = findCell(textLabel->cell->level, textLabel->cell->cellId, textLabel->cell->partitionId);
+		if (c)
 		{
-			std::unordered_map<int, Item::SharedTextLabel>::iterator t = c->second->textLabels.find(textLabel->textLabelId);
-			if (t != c->second->textLabels.end())
+			std::unordered_map<int, Item::SharedTextLabel>::iterator t = c->textLabels.find(textLabel->textLabelId);
+			if (t != c->textLabels.end())
 			{
-				c->second->textLabels.erase(t);
-				eraseCellIfEmpty(c->second);
+				c->textLabels.erase(t);
 				found = true;
 			}
 		}
@@ -534,7 +942,7 @@ void Grid::removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign
 			found = true;
 		}
 	}
-	if (found)
+	if (found || reassign)
 	{
 		if (reassign)
 		{
@@ -547,33 +955,331 @@ void Grid::removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign
 				core->getStreamer()->attachedTextLabels.erase(textLabel);
 			}
 		}
+		if (!reassign || textLabel->cell != c)
+		{
+			if (c)
+			{
+				eraseCellIfEmpty(c);
+			}
+			if (reassign)
+			{
+				relocateVisibleItem(textLabel, textLabel->textLabelId, &Cell::textLabels);
+			}
+		}
 	}
 }
 
-CellId Grid::getCellId(const Eigen::Vector2f &position, bool insert)
+void Grid::reassignItem(int type, int id)
 {
-	static Box2d box;
-	box.min_corner()[0] = std::floor((position[0] / cellSize)) * cellSize;
-	box.min_corner()[1] = std::floor((position[1] / cellSize)) * cellSize;
-	box.max_corner()[0] = box.min_corner()[0] + cellSize;
-	box.max_corner()[1] = box.min_corner()[1] + cellSize;
-	Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(box);
-	CellId cellId = std::make_pair(static_cast<int>(centroid[0]), static_cast<int>(centroid[1]));
-	if (insert)
+	switch (type)
 	{
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(cellId);
-		if (c == cells.end())
+		case STREAMER_TYPE_OBJECT:
+		{
+			std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(id);
+			if (o != core->getData()->objects.end())
+			{
+				removeObject(o->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_PICKUP:
+		{
+			std::unordered_map<int, Item::SharedPickup>::iterator p = core->getData()->pickups.find(id);
+			if (p != core->getData()->pickups.end())
+			{
+				removePickup(p->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_CP:
 		{
-			cells[cellId] = std::make_shared<Cell>(cellId);
+			std::unordered_map<int, Item::SharedCheckpoint>::iterator c = core->getData()->checkpoints.find(id);
+			if (c != core->getData()->checkpoints.end())
+			{
+				removeCheckpoint(c->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_RACE_CP:
+		{
+			std::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = core->getData()->raceCheckpoints.find(id);
+			if (r != core->getData()->raceCheckpoints.end())
+			{
+				removeRaceCheckpoint(r->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_MAP_ICON:
+		{
+			std::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(id);
+			if (m != core->getData()->mapIcons.end())
+			{
+				removeMapIcon(m->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_3D_TEXT_LABEL:
+		{
+			std::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(id);
+			if (t != core->getData()->textLabels.end())
+			{
+				removeTextLabel(t->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_AREA:
+		{
+			std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(id);
+			if (a != core->getData()->areas.end())
+			{
+				removeArea(a->second, true);
+			}
+			break;
+		}
+		case STREAMER_TYPE_ACTOR:
+		{
+			std::unordered_map<int, Item::SharedActor>::iterator a = core->getData()->actors.find(id);
+			if (a != core->getData()->actors.end())
+			{
+				removeActor(a->second, true);
+			}
+			break;
+		}
+	}
+}
+
+SharedCell Grid::findCell(int level, const CellId &cellId, const PartitionId &partitionId)
+{
+	SharedCell cell;
+	std::size_t index = 0;
+	if (getDenseCellIndex(level, cellId, index))
+	{
+		cell = denseCells[index];
+	}
+	else
+	{
+		SharedCell *c = cells[level].find(cellId);
+		if (c)
+		{
+			cell = *c;
+		}
+	}
+	if (cell && partitionId != std::make_pair(-1, -1))
+	{
+		std::unordered_map<PartitionId, SharedCell, pair_hash>::iterator p = cell->partitions.find(partitionId);
+		if (p != cell->partitions.end())
+		{
+			return p->second;
+		}
+		return SharedCell();
+	}
+	return cell;
+}
+
+SharedCell &Grid::insertCell(int level, const CellId &cellId, const PartitionId &partitionId, float comparableDistance, const Eigen::Vector2f &height)
+{
+	std::size_t index = 0;
+	SharedCell *cell = NULL;
+	bool changed = false;
+	if (getDenseCellIndex(level, cellId, index))
+	{
+		cell = &denseCells[index];
+	}
+	else
+	{
+		cell = cells[level].find(cellId);
+		if (!cell)
+		{
+			cell = &cells[level].insert(cellId, std::make_shared<Cell>(cellId, level));
+			changed = true;
+		}
+	}
+	if (!*cell)
+	{
+		*cell = std::make_shared<Cell>(cellId, level);
+		changed = true;
+	}
+	if (comparableDistance > (*cell)->comparableStreamDistance)
+	{
+		(*cell)->comparableStreamDistance = comparableDistance;
+		if (comparableDistance > levelStreamDistances[level])
+		{
+			levelStreamDistances[level] = comparableDistance;
+			++version;
+		}
+		changed = true;
+	}
+	SharedCell *target = cell;
+	if (partitionId != std::make_pair(-1, -1))
+	{
+		target = &(*cell)->partitions[partitionId];
+		if (!*target)
+		{
+			*target = std::make_shared<Cell>(cellId, level);
+			(*target)->partitionId = partitionId;
+			changed = true;
+		}
+		(*target)->comparableStreamDistance = std::max((*target)->comparableStreamDistance, comparableDistance);
+	}
+	if (expandCellHeight(*target, height) || changed)
+	{
+		invalidateNeighbouringCells(level, cellId);
+	}
+	return *target;
+}
+
+bool Grid::expandCellHeight(const SharedCell &cell, const Eigen::Vector2f &height)
+{
+	if (height[0] < cell->height[0] || height[1] > cell->height[1])
+	{
+		cell->height = Eigen::Vector2f(std::min(cell->height[0], height[0]), std::max(cell->height[1], height[1]));
+		return zBandingEnabled;
+	}
+	return false;
+}
+
+void Grid::invalidateNeighbouringCells(int level, const CellId &cellId)
+{
+	if (core->getGrid() != this)
+	{
+		return;
+	}
+	float levelCellSize = getLevelCellSize(level);
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		if (p->second.neighbouringCellsVersion != version)
+		{
+			continue;
+		}
+		float radiusMultiplier = 1.0f;
+		for (std::size_t i = 0; i < STREAMER_MAX_TYPES; ++i)
+		{
+			radiusMultiplier = std::max(radiusMultiplier, p->second.radiusMultipliers[i]);
+		}
+		int radius = static_cast<int>(std::sqrt(levelStreamDistances[level] * radiusMultiplier) / levelCellSize) + 1;
+		CellId playerCellId = getCellId(Eigen::Vector2f(p->second.position[0], p->second.position[1]), level);
+		if (std::abs(playerCellId.first - cellId.first) <= radius && std::abs(playerCellId.second - cellId.second) <= radius)
+		{
+			p->second.neighbouringCellsVersion = 0;
+		}
+	}
+}
+
+template<typename T>
+void Grid::relocateVisibleItem(const std::shared_ptr<T> &item, int id, std::unordered_map<int, std::shared_ptr<T> > Cell::*cellItems)
+{
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		std::unordered_map<int, std::shared_ptr<T> > &outsideItems = p->second.outsideCell.get()->*cellItems, &visibleItems = p->second.visibleCell.get()->*cellItems;
+		bool visible = outsideItems.erase(id) || visibleItems.find(id) != visibleItems.end();
+		if (visible && item->cell && std::find(p->second.neighbouringCells.begin(), p->second.neighbouringCells.end(), item->cell) == p->second.neighbouringCells.end())
+		{
+			outsideItems.insert(std::make_pair(id, item));
+		}
+	}
+}
+
+void Grid::addCellPartitions(const SharedCell &cell, std::vector<SharedCell> &foundCells, const Player *player)
+{
+	foundCells.push_back(cell);
+	if (cell->partitions.empty())
+	{
+		return;
+	}
+	if (player)
+	{
+		std::unordered_map<PartitionId, SharedCell, pair_hash>::iterator p = cell->partitions.end();
+		if (player->worldId >= 0 && player->interiorId >= 0)
+		{
+			p = cell->partitions.find(std::make_pair(player->worldId, player->interiorId));
+			if (p != cell->partitions.end())
+			{
+				foundCells.push_back(p->second);
+			}
+		}
+		if (player->worldId >= 0)
+		{
+			p = cell->partitions.find(std::make_pair(player->worldId, -1));
+			if (p != cell->partitions.end())
+			{
+				foundCells.push_back(p->second);
+			}
+		}
+		if (player->interiorId >= 0)
+		{
+			p = cell->partitions.find(std::make_pair(-1, player->interiorId));
+			if (p != cell->partitions.end())
+			{
+				foundCells.push_back(p->second);
+			}
+		}
+	}
+	else
+	{
+		for (std::unordered_map<PartitionId, SharedCell, pair_hash>::iterator p = cell->partitions.begin(); p != cell->partitions.end(); ++p)
+		{
+			foundCells.push_back(p->second);
 		}
 	}
-	return cellId;
 }
 
+void Grid::findNeighbouringCells(const Eigen::Vector2f &point, std::vector<SharedCell> &foundCells, const Player *player)
+{
+	float radiusMultiplier = 1.0f;
+	if (player)
+	{
+		for (std::size_t i = 0; i < STREAMER_MAX_TYPES; ++i)
+		{
+			radiusMultiplier = std::max(radiusMultiplier, player->radiusMultipliers[i]);
+		}
+	}
+	std::size_t firstCell = foundCells.size();
+	CellId originCellId = getCellId(point);
+	Box2d origin(Eigen::Vector2f(static_cast<float>(originCellId.first) * cellSize, static_cast<float>(originCellId.second) * cellSize), Eigen::Vector2f(static_cast<float>(originCellId.first + 1) * cellSize, static_cast<float>(originCellId.second + 1) * cellSize));
+	for (int level = 0; level < STREAMER_MAX_GRID_LEVELS; ++level)
+	{
+		if (levelStreamDistances[level] < 0.0f)
+		{
+			continue;
+		}
+		float levelCellSize = getLevelCellSize(level);
+		int radius = static_cast<int>(std::sqrt(levelStreamDistances[level] * radiusMultiplier) / levelCellSize) + 1;
+		CellId cellId = getCellId(point, level);
+		for (int x = cellId.first - radius; x <= cellId.first + radius; ++x)
+		{
+			for (int y = cellId.second - radius; y <= cellId.second + radius; ++y)
+			{
+				SharedCell c = findCell(level, std::make_pair(x, y));
+				if (c)
+				{
+					float dx = std::max(0.0f, std::max((static_cast<float>(x) * levelCellSize) - origin.max_corner()[0], origin.min_corner()[0] - (static_cast<float>(x + 1) * levelCellSize)));
+					float dy = std::max(0.0f, std::max((static_cast<float>(y) * levelCellSize) - origin.max_corner()[1], origin.min_corner()[1] - (static_cast<float>(y + 1) * levelCellSize)));
+					if (((dx * dx) + (dy * dy)) <= (c->comparableStreamDistance * radiusMultiplier))
+					{
+						addCellPartitions(c, foundCells, player);
+					}
+				}
+			}
+		}
+	}
+	if (zBandingEnabled && player)
+	{
+		float zBand = std::floor(player->position[2] / zBandHeight) * zBandHeight;
+		std::vector<SharedCell>::iterator f = foundCells.begin() + firstCell;
+		for (std::vector<SharedCell>::iterator c = f; c != foundCells.end(); ++c)
+		{
+			float dz = std::max(0.0f, std::max((*c)->height[0] - (zBand + zBandHeight), zBand - (*c)->height[1]));
+			if ((dz * dz) <= ((*c)->comparableStreamDistance * radiusMultiplier))
+			{
+				*f++ = *c;
+			}
+		}
+		foundCells.erase(f, foundCells.end());
+	}
+}
 
-void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const std::unordered_set<CellId, pair_hash> &discoveredCells)
+void Grid::processDiscoveredCellsForPlayer(Player &player, const std::vector<SharedCell> &discoveredCells)
 {
-	playerCells.push_back(std::make_shared<Cell>());
 	if (player.enabledItems[STREAMER_TYPE_OBJECT])
 	{
 		std::unordered_map<int, Item::SharedObject>::iterator o = player.visibleCell->objects.begin();
@@ -581,8 +1287,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (o->second->cell)
 			{
-				const auto& d = discoveredCells.find(o->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), o->second->cell))
 				{
 					o = player.visibleCell->objects.erase(o);
 				}
@@ -596,7 +1301,8 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				o = player.visibleCell->objects.erase(o);
 			}
 		}
-		playerCells.back()->objects.swap(player.visibleCell->objects);
+		player.outsideCell->objects.clear();
+		player.outsideCell->objects.swap(player.visibleCell->objects);
 	}
 	if (player.enabledItems[STREAMER_TYPE_CP])
 	{
@@ -605,8 +1311,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (c->second->cell)
 			{
-				const auto& d = discoveredCells.find(c->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), c->second->cell))
 				{
 					c = player.visibleCell->checkpoints.erase(c);
 				}
@@ -620,7 +1325,8 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				c = player.visibleCell->checkpoints.erase(c);
 			}
 		}
-		playerCells.back()->checkpoints.swap(player.visibleCell->checkpoints);
+		player.outsideCell->checkpoints.clear();
+		player.outsideCell->checkpoints.swap(player.visibleCell->checkpoints);
 	}
 	if (player.enabledItems[STREAMER_TYPE_RACE_CP])
 	{
@@ -629,8 +1335,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (r->second->cell)
 			{
-				const auto& d = discoveredCells.find(r->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), r->second->cell))
 				{
 					r = player.visibleCell->raceCheckpoints.erase(r);
 				}
@@ -644,7 +1349,8 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				r = player.visibleCell->raceCheckpoints.erase(r);
 			}
 		}
-		playerCells.back()->raceCheckpoints.swap(player.visibleCell->raceCheckpoints);
+		player.outsideCell->raceCheckpoints.clear();
+		player.outsideCell->raceCheckpoints.swap(player.visibleCell->raceCheckpoints);
 	}
 	if (player.enabledItems[STREAMER_TYPE_MAP_ICON])
 	{
@@ -653,8 +1359,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (m->second->cell)
 			{
-				const auto& d = discoveredCells.find(m->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), m->second->cell))
 				{
 					m = player.visibleCell->mapIcons.erase(m);
 				}
@@ -668,7 +1373,8 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				m = player.visibleCell->mapIcons.erase(m);
 			}
 		}
-		playerCells.back()->mapIcons.swap(player.visibleCell->mapIcons);
+		player.outsideCell->mapIcons.clear();
+		player.outsideCell->mapIcons.swap(player.visibleCell->mapIcons);
 	}
 	if (player.enabledItems[STREAMER_TYPE_3D_TEXT_LABEL])
 	{
@@ -677,8 +1383,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (t->second->cell)
 			{
-				const auto& d = discoveredCells.find(t->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), t->second->cell))
 				{
 					t = player.visibleCell->textLabels.erase(t);
 				}
@@ -692,7 +1397,8 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				t = player.visibleCell->textLabels.erase(t);
 			}
 		}
-		playerCells.back()->textLabels.swap(player.visibleCell->textLabels);
+		player.outsideCell->textLabels.clear();
+		player.outsideCell->textLabels.swap(player.visibleCell->textLabels);
 	}
 	if (player.enabledItems[STREAMER_TYPE_AREA])
 	{
@@ -701,8 +1407,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (a->second->cell)
 			{
-				const auto& d = discoveredCells.find(a->second->cell->cellId);
-				if (d != discoveredCells.end())
+				if (std::binary_search(discoveredCells.begin(), discoveredCells.end(), a->second->cell))
 				{
 					a = player.visibleCell->areas.erase(a);
 				}
@@ -716,65 +1421,192 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 				a = player.visibleCell->areas.erase(a);
 			}
 		}
-		playerCells.back()->areas.swap(player.visibleCell->areas);
+		player.outsideCell->areas.clear();
+		player.outsideCell->areas.swap(player.visibleCell->areas);
 	}
 }
 
-void Grid::findAllCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells)
+bool Grid::updateNeighbouringCellsForPlayer(Player &player)
 {
-	std::unordered_set<CellId, pair_hash> discoveredCells;
-	for (int i = 0; i < translationMatrix.cols(); ++i)
+	CellId cellId = getCellId(Eigen::Vector2f(player.position[0], player.position[1]));
+	int zBand = zBandingEnabled ? static_cast<int>(std::floor(player.position[2] / zBandHeight)) : 0;
+	if (player.neighbouringCellsVersion == version && player.neighbouringCellId == cellId && player.neighbouringWorldId == player.worldId && player.neighbouringInteriorId == player.interiorId && player.neighbouringZBand == zBand)
 	{
-		Eigen::Vector2f position = Eigen::Vector2f(player.position[0], player.position[1]) + translationMatrix.col(i);
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(getCellId(position, false));
-		if (c != cells.end())
-		{
-			discoveredCells.insert(c->first);
-			playerCells.push_back(c->second);
-		}
+		return false;
+	}
+	player.neighbouringCells.clear();
+	findNeighbouringCells(Eigen::Vector2f(player.position[0], player.position[1]), player.neighbouringCells, &player);
+	player.neighbouringCellId = cellId;
+	player.neighbouringCellsVersion = version;
+	player.neighbouringInteriorId = player.interiorId;
+	player.neighbouringWorldId = player.worldId;
+	player.neighbouringZBand = zBand;
+	return true;
+}
+
+void Grid::findAllCellsForPlayer(Player &player, std::vector<Cell*> &playerCells)
+{
+	if (updateNeighbouringCellsForPlayer(player) || player.neighbouringCellsStale)
+	{
+		player.scratchCells.assign(player.neighbouringCells.begin(), player.neighbouringCells.end());
+		std::sort(player.scratchCells.begin(), player.scratchCells.end());
+		processDiscoveredCellsForPlayer(player, player.scratchCells);
+		player.neighbouringCellsStale = false;
+		player.safeDistance = 0.0f;
+	}
+	for (std::vector<SharedCell>::const_iterator c = player.neighbouringCells.begin(); c != player.neighbouringCells.end(); ++c)
+	{
+		playerCells.push_back(c->get());
 	}
-	processDiscoveredCellsForPlayer(player, playerCells, discoveredCells);
-	playerCells.push_back(globalCell);
+	playerCells.push_back(player.outsideCell.get());
+	playerCells.push_back(globalCell.get());
 }
 
-void Grid::findMinimalCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells)
+void Grid::findPrefetchCellsForPlayer(Player &player, const Eigen::Vector3f &offset, std::vector<Cell*> &playerCells)
 {
-	for (int i = 0; i < translationMatrix.cols(); ++i)
+	Eigen::Vector2f origin(player.position[0], player.position[1]), path(offset[0], offset[1]);
+	std::size_t steps = static_cast<std::size_t>(std::ceil(path.norm() / cellSize));
+	player.scratchCells.clear();
+	for (std::size_t i = 1; i <= steps; ++i)
 	{
-		Eigen::Vector2f position = Eigen::Vector2f(player.position[0], player.position[1]) + translationMatrix.col(i);
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(getCellId(position, false));
-		if (c != cells.end())
+		findNeighbouringCells(Eigen::Vector2f(origin + (path * (static_cast<float>(i) / static_cast<float>(steps)))), player.scratchCells, &player);
+	}
+	for (std::vector<SharedCell>::const_iterator c = player.scratchCells.begin(); c != player.scratchCells.end(); ++c)
+	{
+		if (std::find(playerCells.begin(), playerCells.end(), c->get()) == playerCells.end())
 		{
-			playerCells.push_back(c->second);
+			playerCells.push_back(c->get());
 		}
 	}
-	playerCells.push_back(globalCell);
+}
+
+void Grid::findMinimalCellsForPlayer(Player &player, std::vector<Cell*> &playerCells)
+{
+	if (updateNeighbouringCellsForPlayer(player))
+	{
+		player.neighbouringCellsStale = true;
+	}
+	for (std::vector<SharedCell>::const_iterator c = player.neighbouringCells.begin(); c != player.neighbouringCells.end(); ++c)
+	{
+		playerCells.push_back(c->get());
+	}
+	playerCells.push_back(globalCell.get());
 }
 
 void Grid::findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells)
 {
-	for (int i = 0; i < translationMatrix.cols(); ++i)
+	findNeighbouringCells(point, pointCells, NULL);
+	pointCells.push_back(globalCell);
+}
+
+void Grid::findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells, float range)
+{
+	for (std::vector<SharedCell>::iterator c = denseCells.begin(); c != denseCells.end(); ++c)
+	{
+		if (*c && isCellInRange(*c, point, range))
+		{
+			addCellPartitions(*c, pointCells, NULL);
+		}
+	}
+	for (std::vector<CellMap>::iterator l = cells.begin(); l != cells.end(); ++l)
 	{
-		Eigen::Vector2f position = point + translationMatrix.col(i);
-		std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.find(getCellId(position, false));
-		if (c != cells.end())
+		for (CellMap::iterator c = l->begin(); c != l->end(); ++c)
 		{
-			pointCells.push_back(c->second);
+			if (isCellInRange(*c, point, range))
+			{
+				addCellPartitions(*c, pointCells, NULL);
+			}
 		}
 	}
 	pointCells.push_back(globalCell);
 }
 
-void Grid::findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells, float range)
+void Grid::findAreasForPoint(const Eigen::Vector2f &point, std::vector<Item::SharedArea> &pointAreas)
+{
+	findIndexedAreas(Box2d(point, point), pointAreas);
+}
+
+void Grid::findAreasForLine(const Eigen::Vector2f &lineStart, const Eigen::Vector2f &lineEnd, std::vector<Item::SharedArea> &lineAreas)
+{
+	findIndexedAreas(Box2d(lineStart.cwiseMin(lineEnd), lineStart.cwiseMax(lineEnd)), lineAreas);
+}
+
+Box2d Grid::getAreaBoundingBox(const Item::SharedArea &area)
+{
+	Box2d box;
+	switch (area->type)
+	{
+		case STREAMER_AREA_TYPE_CIRCLE:
+		case STREAMER_AREA_TYPE_CYLINDER:
+		{
+			Eigen::Vector2f center = std::get<Eigen::Vector2f>(area->position);
+			box = Box2d(center - Eigen::Vector2f::Constant(area->size), center + Eigen::Vector2f::Constant(area->size));
+			break;
+		}
+		case STREAMER_AREA_TYPE_SPHERE:
+		{
+			Eigen::Vector2f center = std::get<Eigen::Vector3f>(area->position).head<2>();
+			box = Box2d(center - Eigen::Vector2f::Constant(area->size), center + Eigen::Vector2f::Constant(area->size));
+			break;
+		}
+		case STREAMER_AREA_TYPE_RECTANGLE:
+		{
+			box = std::get<Box2d>(area->position);
+			break;
+		}
+		case STREAMER_AREA_TYPE_CUBOID:
+		{
+			const Box3d &cuboid = std::get<Box3d>(area->position);
+			box = Box2d(Eigen::Vector2f(cuboid.min_corner()[0], cuboid.min_corner()[1]), Eigen::Vector2f(cuboid.max_corner()[0], cuboid.max_corner()[1]));
+			break;
+		}
+		case STREAMER_AREA_TYPE_POLYGON:
+		{
+			boost::geometry::envelope(std::get<Polygon2d>(area->position), box);
+			break;
+		}
+	}
+	return box;
+}
+
+void Grid::indexArea(const Item::SharedArea &area)
+{
+	unindexArea(area->areaId);
+	if (!area->attach)
+	{
+		Box2d box = getAreaBoundingBox(area);
+		areaTree.insert(std::make_pair(box, area->areaId));
+		areaBoxes.insert(std::make_pair(area->areaId, box));
+	}
+}
+
+void Grid::unindexArea(int areaId)
+{
+	std::unordered_map<int, Box2d>::iterator b = areaBoxes.find(areaId);
+	if (b != areaBoxes.end())
+	{
+		areaTree.remove(std::make_pair(b->second, areaId));
+		areaBoxes.erase(b);
+	}
+}
+
+void Grid::findIndexedAreas(const Box2d &box, std::vector<Item::SharedArea> &foundAreas)
 {
-	for (std::unordered_map<CellId, SharedCell, pair_hash>::iterator c = cells.begin(); c != cells.end(); ++c)
+	std::vector<std::pair<Box2d, int> > results;
+	areaTree.query(boost::geometry::index::intersects(box), std::back_inserter(results));
+	for (std::vector<std::pair<Box2d, int> >::iterator r = results.begin(); r != results.end(); ++r)
 	{
-		Eigen::Vector2f corner(static_cast<float>(c->first.first) - (cellSize / 2.0f), static_cast<float>(c->first.second) - (cellSize / 2.0f));
-		Eigen::Vector2f delta(point[0] - std::max(corner[0], std::min(point[0], corner[0] + cellSize)), point[1] - std::max(corner[1], std::min(point[1], corner[1] + cellSize)));
-		if (((delta[0] * delta[0]) + (delta[1] * delta[1])) < range)
+		std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(r->second);
+		if (a != core->getData()->areas.end() && !a->second->attach)
 		{
-			pointCells.push_back(c->second);
+			foundAreas.push_back(a->second);
+		}
+	}
+	for (std::unordered_set<Item::SharedArea>::iterator a = core->getStreamer()->attachedAreas.begin(); a != core->getStreamer()->attachedAreas.end(); ++a)
+	{
+		if ((*a)->attach)
+		{
+			foundAreas.push_back(*a);
 		}
 	}
-	pointCells.push_back(globalCell);
 }
@@ -17,7 +17,7 @@
 #ifndef GRID_H
 #define GRID_H
 
-#include "cell.h"
+#include "cell-map.h"
 
 class Grid
 {
@@ -35,7 +35,7 @@ public:
 
 	inline float getCellSize()
 	{
-		return cellSize;
+		return requestedCellSize;
 	}
 
 	inline float getCellDistance()
@@ -45,7 +45,7 @@ public:
 
 	inline void setCellSize(float size)
 	{
-		cellSize = size;
+		requestedCellSize = size;
 	}
 
 	inline void setCellDistance(float distance)
@@ -54,7 +54,60 @@ public:
 		comparableCellDistance = distance * distance;
 	}
 
+	inline bool isDenseGridEnabled()
+	{
+		return denseGridEnabled;
+	}
+
+	inline float getDenseGridExtent()
+	{
+		return denseGridExtent;
+	}
+
+	inline void setDenseGrid(bool enabled, float extent)
+	{
+		denseGridEnabled = enabled;
+		denseGridExtent = std::fabs(extent);
+	}
+
+	inline bool isIncrementalRebuildEnabled()
+	{
+		return incrementalRebuildEnabled;
+	}
+
+	inline bool isRebuilding()
+	{
+		return nextGrid != NULL;
+	}
+
+	inline void setIncrementalRebuild(bool enabled, std::size_t items)
+	{
+		incrementalRebuildEnabled = enabled;
+		incrementalRebuildItems = std::max<std::size_t>(items, 1);
+	}
+
+	inline bool isZBandingEnabled()
+	{
+		return zBandingEnabled;
+	}
+
+	inline float getZBandHeight()
+	{
+		return zBandHeight;
+	}
+
+	inline void setZBanding(bool enabled, float height)
+	{
+		zBandingEnabled = enabled;
+		zBandHeight = std::max(std::fabs(height), 1.0f);
+		++version;
+	}
+
 	void rebuildGrid();
+	void processIncrementalRebuild();
+
+	std::size_t freezeStaticLayer();
+	void thawObject(int objectId);
 
 	void removeActor(const Item::SharedActor &actor, bool reassign = false);
 	void removeArea(const Item::SharedArea &area, bool reassign = false);
@@ -65,35 +118,236 @@ public:
 	void removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint, bool reassign = false);
 	void removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign = false);
 
-	void findAllCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells);
-	void findMinimalCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells);
+	void reassignItem(int type, int id);
+
+	void findAllCellsForPlayer(Player &player, std::vector<Cell*> &playerCells);
+	void findMinimalCellsForPlayer(Player &player, std::vector<Cell*> &playerCells);
+	void findPrefetchCellsForPlayer(Player &player, const Eigen::Vector3f &offset, std::vector<Cell*> &playerCells);
 	void findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells);
 	void findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells, float range);
+
+	void findAreasForPoint(const Eigen::Vector2f &point, std::vector<Item::SharedArea> &pointAreas);
+	void findAreasForLine(const Eigen::Vector2f &lineStart, const Eigen::Vector2f &lineEnd, std::vector<Item::SharedArea> &lineAreas);
 private:
 	float cellDistance;
 	float cellSize;
 	float comparableCellDistance;
 	SharedCell globalCell;
+	float requestedCellSize;
+	std::size_t version;
+
+	bool incrementalRebuildEnabled;
+	std::size_t incrementalRebuildItems;
+	std::size_t incrementalRebuildIndex;
+	int incrementalRebuildType;
+	std::unique_ptr<Grid> nextGrid;
+	std::unordered_set<std::pair<int, int>, pair_hash> rebuildChangedItems;
+
+	std::vector<std::pair<Item::SharedActor, SharedCell> > rebuildActors;
+	std::vector<std::pair<Item::SharedArea, SharedCell> > rebuildAreas;
+	std::vector<std::pair<Item::SharedCheckpoint, SharedCell> > rebuildCheckpoints;
+	std::vector<std::pair<Item::SharedMapIcon, SharedCell> > rebuildMapIcons;
+	std::vector<std::pair<Item::SharedObject, SharedCell> > rebuildObjects;
+	std::vector<std::pair<Item::SharedPickup, SharedCell> > rebuildPickups;
+	std::vector<std::pair<Item::SharedRaceCheckpoint, SharedCell> > rebuildRaceCheckpoints;
+	std::vector<std::pair<Item::SharedTextLabel, SharedCell> > rebuildTextLabels;
 
-	std::unordered_map<CellId, SharedCell, pair_hash> cells;
-	Eigen::Matrix<float, 2, 9> translationMatrix;
+	bool zBandingEnabled;
+	float zBandHeight;
+
+	bool denseGridEnabled;
+	float denseGridExtent;
+	int denseGridOffset;
+	int denseGridWidth;
+
+	std::vector<CellMap> cells;
+	std::vector<float> levelStreamDistances;
+
+	boost::geometry::index::rtree<std::pair<Box2d, int>, boost::geometry::index::rstar<16> > areaTree;
+	std::unordered_map<int, Box2d> areaBoxes;
+	std::vector<SharedCell> denseCells;
+
+	inline void calculateDenseGrid()
+	{
+		denseCells.clear();
+		denseGridOffset = 0;
+		denseGridWidth = 0;
+		if (denseGridEnabled && cellSize > 0.0f)
+		{
+			denseGridOffset = std::min(static_cast<int>(std::ceil(denseGridExtent / cellSize)), STREAMER_MAX_DENSE_GRID_WIDTH / 2);
+			denseGridWidth = denseGridOffset * 2;
+			denseCells.resize(static_cast<std::size_t>(denseGridWidth) * static_cast<std::size_t>(denseGridWidth));
+		}
+	}
+
+	inline bool getDenseCellIndex(int level, const CellId &cellId, std::size_t &index)
+	{
+		if (level)
+		{
+			return false;
+		}
+		int x = cellId.first + denseGridOffset, y = cellId.second + denseGridOffset;
+		if (x >= 0 && x < denseGridWidth && y >= 0 && y < denseGridWidth)
+		{
+			index = (static_cast<std::size_t>(y) * static_cast<std::size_t>(denseGridWidth)) + static_cast<std::size_t>(x);
+			return true;
+		}
+		return false;
+	}
 
-	inline void calculateTranslationMatrix()
+	inline bool isCellEmpty(const SharedCell &passedCell)
 	{
-		translationMatrix << 0.0f, 0.0f, cellSize, cellSize, cellSize * -1.0f, 0.0f, cellSize * -1.0f, cellSize, cellSize * -1.0f,
-		                     0.0f, cellSize, 0.0f, cellSize, 0.0f, cellSize * -1.0f, cellSize, cellSize * -1.0f, cellSize * -1.0f;
+		return passedCell->areas.empty() && passedCell->checkpoints.empty() && passedCell->mapIcons.empty() && passedCell->objects.empty() && passedCell->frozenObjects.empty() && passedCell->pickups.empty() && passedCell->raceCheckpoints.empty() && passedCell->textLabels.empty() && passedCell->actors.empty() && passedCell->partitions.empty();
 	}
 
 	inline void eraseCellIfEmpty(const SharedCell &passedCell)
 	{
-		if (passedCell->areas.empty() && passedCell->checkpoints.empty() && passedCell->mapIcons.empty() && passedCell->objects.empty() && passedCell->pickups.empty() && passedCell->raceCheckpoints.empty() && passedCell->textLabels.empty() && passedCell->actors.empty())
+		if (passedCell->partitionId != std::make_pair(-1, -1))
+		{
+			if (isCellEmpty(passedCell))
+			{
+				SharedCell c = findCell(passedCell->level, passedCell->cellId);
+				if (c)
+				{
+					c->partitions.erase(passedCell->partitionId);
+					eraseCellIfEmpty(c);
+				}
+			}
+			return;
+		}
+		if (isCellEmpty(passedCell))
+		{
+			std::size_t index = 0;
+			if (getDenseCellIndex(passedCell->level, passedCell->cellId, index))
+			{
+				denseCells[index].reset();
+			}
+			else
+			{
+				cells[passedCell->level].erase(passedCell->cellId);
+			}
+		}
+	}
+
+	template<typename T>
+	inline PartitionId getPartitionId(const T &item)
+	{
+		return std::make_pair(item->worlds.size() == 1 ? *item->worlds.begin() : -1, item->interiors.size() == 1 ? *item->interiors.begin() : -1);
+	}
+
+	inline float getLevelCellSize(int level)
+	{
+		return cellSize * static_cast<float>(1 << level);
+	}
+
+	inline int getCellLevel(float comparableDistance)
+	{
+		float levelDistance = cellDistance;
+		for (int level = 0; level < STREAMER_MAX_GRID_LEVELS; ++level)
+		{
+			if (comparableDistance <= levelDistance)
+			{
+				return level;
+			}
+			levelDistance *= 4.0f;
+		}
+		return -1;
+	}
+
+	inline CellId getCellId(const Eigen::Vector2f &position, int level = 0)
+	{
+		float levelCellSize = getLevelCellSize(level);
+		return std::make_pair(static_cast<int>(std::floor(position[0] / levelCellSize)), static_cast<int>(std::floor(position[1] / levelCellSize)));
+	}
+
+	inline bool isCellInRange(const SharedCell &cell, const Eigen::Vector2f &point, float range)
+	{
+		float levelCellSize = getLevelCellSize(cell->level);
+		Eigen::Vector2f corner(static_cast<float>(cell->cellId.first) * levelCellSize, static_cast<float>(cell->cellId.second) * levelCellSize);
+		Eigen::Vector2f delta(point[0] - std::max(corner[0], std::min(point[0], corner[0] + levelCellSize)), point[1] - std::max(corner[1], std::min(point[1], corner[1] + levelCellSize)));
+		return ((delta[0] * delta[0]) + (delta[1] * delta[1])) < range;
+	}
+
+	template<typename T>
+	inline void snapshotItems(const std::unordered_map<int, std::shared_ptr<T> > &items, std::vector<std::pair<std::shared_ptr<T>, SharedCell> > &placements)
+	{
+		placements.clear();
+		placements.reserve(items.size());
+		for (typename std::unordered_map<int, std::shared_ptr<T> >::const_iterator i = items.begin(); i != items.end(); ++i)
 		{
-			cells.erase(passedCell->cellId);
+			placements.push_back(std::make_pair(i->second, SharedCell()));
 		}
 	}
 
-	CellId getCellId(const Eigen::Vector2f &position, bool insert = true);
-	void processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const std::unordered_set<CellId, pair_hash> &discoveredCells);
+	template<typename T>
+	inline bool placeItems(std::vector<std::pair<std::shared_ptr<T>, SharedCell> > &placements, void (Grid::*add)(const std::shared_ptr<T> &), std::size_t &remaining)
+	{
+		while (incrementalRebuildIndex < placements.size())
+		{
+			if (!remaining)
+			{
+				return false;
+			}
+			std::pair<std::shared_ptr<T>, SharedCell> &p = placements[incrementalRebuildIndex++];
+			SharedCell cell = p.first->cell;
+			(nextGrid.get()->*add)(p.first);
+			p.second = p.first->cell;
+			p.first->cell = cell;
+			--remaining;
+		}
+		return true;
+	}
+
+	template<typename T>
+	inline void applyPlacements(std::vector<std::pair<std::shared_ptr<T>, SharedCell> > &placements, std::unordered_map<int, std::shared_ptr<T> > &items, std::unordered_map<int, std::shared_ptr<T> > Cell::*cellItems, int T::*itemId, int type)
+	{
+		for (typename std::vector<std::pair<std::shared_ptr<T>, SharedCell> >::iterator p = placements.begin(); p != placements.end(); ++p)
+		{
+			int id = p->first.get()->*itemId;
+			if (rebuildChangedItems.find(std::make_pair(type, id)) != rebuildChangedItems.end())
+			{
+				typename std::unordered_map<int, std::shared_ptr<T> >::iterator i = items.find(id);
+				if (i == items.end() || i->second != p->first)
+				{
+					if (p->second)
+					{
+						(p->second.get()->*cellItems).erase(id);
+						eraseCellIfEmpty(p->second);
+					}
+					else
+					{
+						(globalCell.get()->*cellItems).erase(id);
+					}
+					continue;
+				}
+			}
+			p->first->cell = p->second;
+		}
+		placements.clear();
+		placements.shrink_to_fit();
+	}
+
+	void clearGrid();
+
+	std::size_t freezeCell(const SharedCell &cell);
+	bool eraseFrozenObject(const SharedCell &cell, int objectId);
+
+	Box2d getAreaBoundingBox(const Item::SharedArea &area);
+	void indexArea(const Item::SharedArea &area);
+	void unindexArea(int areaId);
+	void findIndexedAreas(const Box2d &box, std::vector<Item::SharedArea> &foundAreas);
+	void finishIncrementalRebuild();
+
+	SharedCell findCell(int level, const CellId &cellId, const PartitionId &partitionId = std::make_pair(-1, -1));
+	SharedCell &insertCell(int level, const CellId &cellId, const PartitionId &partitionId, float comparableDistance, const Eigen::Vector2f &height);
+	bool expandCellHeight(const SharedCell &cell, const Eigen::Vector2f &height);
+	void invalidateNeighbouringCells(int level, const CellId &cellId);
+	template<typename T>
+	void relocateVisibleItem(const std::shared_ptr<T> &item, int id, std::unordered_map<int, std::shared_ptr<T> > Cell::*cellItems);
+	void addCellPartitions(const SharedCell &cell, std::vector<SharedCell> &foundCells, const Player *player);
+	void findNeighbouringCells(const Eigen::Vector2f &point, std::vector<SharedCell> &foundCells, const Player *player);
+	bool updateNeighbouringCellsForPlayer(Player &player);
+	void processDiscoveredCellsForPlayer(Player &player, const std::vector<SharedCell> &discoveredCells);
 };
 
 #endif
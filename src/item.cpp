@@ -31,15 +31,27 @@ Identifier Item::Actor::identifier;
 Item::Area::Area() : references(0) {}
 Item::Area::Attach::Attach() : references(0) {}
 Item::Checkpoint::Checkpoint() : references(0) {}
-Item::MapIcon::MapIcon() : references(0) {}
-Item::Object::Object() : references(0) {}
+Item::MapIcon::MapIcon() : references(0), streamOutGrace(-1), streamOutMargin(-1.0f) {}
+Item::Object::Object() : references(0), streamOutGrace(-1), streamOutMargin(-1.0f) {}
 Item::Object::Attach::Attach() : references(0) {}
 Item::Object::Material::Main::Main() : references(0) {}
 Item::Object::Material::Text::Text() : references(0) {}
 Item::Object::Move::Move() : references(0) {}
 Item::Pickup::Pickup() : references(0) {}
 Item::RaceCheckpoint::RaceCheckpoint() : references(0) {}
-Item::TextLabel::TextLabel() : references(0) {}
+Item::TextLabel::TextLabel() : references(0), streamOutGrace(-1), streamOutMargin(-1.0f) {}
 Item::TextLabel::Attach::Attach() : references(0) {}
-Item::Actor::Actor() : references(0) {}
+Item::Actor::Actor() : references(0), streamOutGrace(-1), streamOutMargin(-1.0f) {}
 Item::Actor::Anim::Anim() : references(0) {}
+
+Item::FrozenObject::FrozenObject(const SharedObject &object) : object(object)
+{
+	objectId = object->objectId;
+	priority = object->priority;
+	comparableStreamDistance = object->comparableStreamDistance;
+	height = object->position[2];
+	position = object->position + object->positionOffset;
+	interiorId = object->interiors.empty() ? -1 : *object->interiors.begin();
+	worldId = object->worlds.empty() ? -1 : *object->worlds.begin();
+	restricted = object->interiors.size() > 1 || object->worlds.size() > 1 || (!object->interiors.empty() && interiorId < 0) || (!object->worlds.empty() && worldId < 0) || !object->players.all() || !object->areas.empty();
+}
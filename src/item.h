@@ -41,6 +41,8 @@ namespace Item
 		int references;
 		float rotation;
 		float streamDistance;
+		int streamOutGrace;
+		float streamOutMargin;
 
 		struct Anim
 		{
@@ -164,6 +166,8 @@ namespace Item
 		int references;
 		bool streamCallbacks;
 		float streamDistance;
+		int streamOutGrace;
+		float streamOutMargin;
 		int style;
 		int type;
 
@@ -200,6 +204,8 @@ namespace Item
 		Eigen::Vector3f rotation;
 		bool streamCallbacks;
 		float streamDistance;
+		int streamOutGrace;
+		float streamOutMargin;
 
 		struct Attach
 		{
@@ -284,6 +290,34 @@ namespace Item
 		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 	};
 
+	struct FrozenObject
+	{
+		FrozenObject(const SharedObject &object);
+
+		int objectId;
+		int priority;
+		float comparableStreamDistance;
+		float height;
+		Eigen::Vector3f position;
+		int interiorId;
+		int worldId;
+		bool restricted;
+		SharedObject object;
+	};
+
+	struct FrozenObjectCompare
+	{
+		bool operator()(const FrozenObject &a, const FrozenObject &b) const
+		{
+			return a.objectId < b.objectId;
+		}
+
+		bool operator()(const FrozenObject &a, int b) const
+		{
+			return a.objectId < b;
+		}
+	};
+
 	struct Pickup
 	{
 		Pickup();
@@ -364,6 +398,8 @@ namespace Item
 		int references;
 		bool streamCallbacks;
 		float streamDistance;
+		int streamOutGrace;
+		float streamOutMargin;
 		bool testLOS;
 		std::string text;
 		int textLabelId;
@@ -73,6 +73,35 @@ AMX_NATIVE_INFO natives[] =
 	{ "Streamer_SetCellDistance", Natives::Streamer_SetCellDistance },
 	{ "Streamer_GetCellSize", Natives::Streamer_GetCellSize },
 	{ "Streamer_SetCellSize", Natives::Streamer_SetCellSize },
+	{ "Streamer_ToggleDenseGrid", Natives::Streamer_ToggleDenseGrid },
+	{ "Streamer_IsToggleDenseGrid", Natives::Streamer_IsToggleDenseGrid },
+	{ "Streamer_ToggleIncrementalRebuild", Natives::Streamer_ToggleIncrementalRebuild },
+	{ "Streamer_IsToggleIncrementalRebuild", Natives::Streamer_IsToggleIncrementalRebuild },
+	{ "Streamer_IsGridRebuilding", Natives::Streamer_IsGridRebuilding },
+	{ "Streamer_FreezeStaticLayer", Natives::Streamer_FreezeStaticLayer },
+	{ "Streamer_GetVerticalRanges", Natives::Streamer_GetVerticalRanges },
+	{ "Streamer_SetVerticalRanges", Natives::Streamer_SetVerticalRanges },
+	{ "Streamer_ToggleZBanding", Natives::Streamer_ToggleZBanding },
+	{ "Streamer_IsToggleZBanding", Natives::Streamer_IsToggleZBanding },
+	{ "Streamer_GetWorkerThreads", Natives::Streamer_GetWorkerThreads },
+	{ "Streamer_SetWorkerThreads", Natives::Streamer_SetWorkerThreads },
+	{ "Streamer_ToggleStaggeredUpdates", Natives::Streamer_ToggleStaggeredUpdates },
+	{ "Streamer_IsToggleStaggeredUpdates", Natives::Streamer_IsToggleStaggeredUpdates },
+	{ "Streamer_GetTickBudget", Natives::Streamer_GetTickBudget },
+	{ "Streamer_SetTickBudget", Natives::Streamer_SetTickBudget },
+	{ "Streamer_GetUpdateQueue", Natives::Streamer_GetUpdateQueue },
+	{ "Streamer_ToggleSafeDistance", Natives::Streamer_ToggleSafeDistance },
+	{ "Streamer_IsToggleSafeDistance", Natives::Streamer_IsToggleSafeDistance },
+	{ "Streamer_GetStreamOutHysteresis", Natives::Streamer_GetStreamOutHysteresis },
+	{ "Streamer_SetStreamOutHysteresis", Natives::Streamer_SetStreamOutHysteresis },
+	{ "Streamer_GetPrefetchUpdates", Natives::Streamer_GetPrefetchUpdates },
+	{ "Streamer_SetPrefetchUpdates", Natives::Streamer_SetPrefetchUpdates },
+	{ "Streamer_GetChunkTargetTime", Natives::Streamer_GetChunkTargetTime },
+	{ "Streamer_SetChunkTargetTime", Natives::Streamer_SetChunkTargetTime },
+	{ "Streamer_GetCreationBudget", Natives::Streamer_GetCreationBudget },
+	{ "Streamer_SetCreationBudget", Natives::Streamer_SetCreationBudget },
+	{ "Streamer_GetByteBudget", Natives::Streamer_GetByteBudget },
+	{ "Streamer_SetByteBudget", Natives::Streamer_SetByteBudget },
 	{ "Streamer_ToggleItemStatic", Natives::Streamer_ToggleItemStatic },
 	{ "Streamer_IsToggleItemStatic", Natives::Streamer_IsToggleItemStatic },
 	{ "Streamer_ToggleItemInvAreas", Natives::Streamer_ToggleItemInvAreas },
@@ -92,6 +121,7 @@ AMX_NATIVE_INFO natives[] =
 	{ "Streamer_ToggleItemUpdate", Natives::Streamer_ToggleItemUpdate },
 	{ "Streamer_IsToggleItemUpdate", Natives::Streamer_IsToggleItemUpdate },
 	{ "Streamer_GetLastUpdateTime", Natives::Streamer_GetLastUpdateTime },
+	{ "Streamer_GetTickAllocations", Natives::Streamer_GetTickAllocations },
 	{ "Streamer_Update", Natives::Streamer_Update },
 	{ "Streamer_UpdateEx", Natives::Streamer_UpdateEx },
 	// Data Manipulation
@@ -25,12 +25,15 @@
 #include <boost/bimap/unordered_set_of.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 #include <Eigen/Core>
 
 #include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <map>
@@ -49,6 +52,8 @@
 
 #include <thread>
 #include <atomic>  // Adiciona a dependência para std::atomic
+#include <condition_variable>
+#include <mutex>
 
 #include "common.h"
 #include "sampgdk.h"
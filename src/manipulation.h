@@ -72,7 +72,9 @@ namespace Manipulation
 		WorldId,
 		X,
 		Y,
-		Z
+		Z,
+		StreamOutGrace,
+		StreamOutMargin
 	};
 
 	enum
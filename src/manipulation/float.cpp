@@ -203,6 +203,11 @@ int Manipulation::getFloatData(AMX *amx, cell *params)
 						Utility::storeFloatInNative(amx, params[4], o->second->streamDistance);
 						return 1;
 					}
+					case StreamOutMargin:
+					{
+						Utility::storeFloatInNative(amx, params[4], o->second->streamOutMargin);
+						return 1;
+					}
 					case X:
 					{
 						Utility::storeFloatInNative(amx, params[4], o->second->position[0]);
@@ -388,6 +393,11 @@ int Manipulation::getFloatData(AMX *amx, cell *params)
 						Utility::storeFloatInNative(amx, params[4], m->second->streamDistance);
 						return 1;
 					}
+					case StreamOutMargin:
+					{
+						Utility::storeFloatInNative(amx, params[4], m->second->streamOutMargin);
+						return 1;
+					}
 					case X:
 					{
 						Utility::storeFloatInNative(amx, params[4], m->second->position[0]);
@@ -478,6 +488,11 @@ int Manipulation::getFloatData(AMX *amx, cell *params)
 						Utility::storeFloatInNative(amx, params[4], t->second->position[2]);
 						return 1;
 					}
+					case StreamOutMargin:
+					{
+						Utility::storeFloatInNative(amx, params[4], t->second->streamOutMargin);
+						return 1;
+					}
 					default:
 					{
 						error = InvalidData;
@@ -774,6 +789,11 @@ int Manipulation::getFloatData(AMX *amx, cell *params)
 						Utility::storeFloatInNative(amx, params[4], a->second->rotation);
 						return 1;
 					}
+					case StreamOutMargin:
+					{
+						Utility::storeFloatInNative(amx, params[4], a->second->streamOutMargin);
+						return 1;
+					}
 					case X:
 					{
 						Utility::storeFloatInNative(amx, params[4], a->second->position[0]);
@@ -938,6 +958,11 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						reassign = true;
 						break;
 					}
+					case StreamOutMargin:
+					{
+						o->second->streamOutMargin = amx_ctof(params[4]);
+						return 1;
+					}
 					case X:
 					{
 						if (o->second->move)
@@ -1010,7 +1035,7 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 										static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
 										if (native != NULL)
 										{
-											sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
+											Utility::callAttachNative(native, p->first, i->second, j->second, o->second->attach->positionOffset, o->second->attach->rotation, o->second->attach->syncRotation);
 										}
 									}
 								}
@@ -1019,7 +1044,7 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 									static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
 									if (native != NULL)
 									{
-										sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 1);
+										Utility::callAttachNative(native, p->first, i->second, o->second->attach->player, o->second->attach->positionOffset, o->second->attach->rotation, 1);
 									}
 								}
 								else if (o->second->attach->vehicle != INVALID_VEHICLE_ID)
@@ -1323,6 +1348,11 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						reassign = true;
 						break;
 					}
+					case StreamOutMargin:
+					{
+						m->second->streamOutMargin = amx_ctof(params[4]);
+						return 1;
+					}
 					case X:
 					{
 						m->second->position[0] = amx_ctof(params[4]);
@@ -1431,6 +1461,11 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						update = true;
 						break;
 					}
+					case StreamOutMargin:
+					{
+						t->second->streamOutMargin = amx_ctof(params[4]);
+						return 1;
+					}
 					default:
 					{
 						error = InvalidData;
@@ -1739,6 +1774,15 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						update = true;
 						break;
 					}
+					case StreamOutMargin:
+					{
+						a->second->streamOutMargin = amx_ctof(params[4]);
+						if (a->second->cell)
+						{
+							core->getGrid()->removeActor(a->second, true);
+						}
+						return 1;
+					}
 					case X:
 					{
 						a->second->position[0] = amx_ctof(params[4]);
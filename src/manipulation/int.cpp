@@ -80,6 +80,10 @@ int Manipulation::getIntData(AMX *amx, cell *params)
 					{
 						return o->second->priority;
 					}
+					case StreamOutGrace:
+					{
+						return o->second->streamOutGrace;
+					}
 					case SyncRotation:
 					{
 						if (o->second->attach)
@@ -315,6 +319,10 @@ int Manipulation::getIntData(AMX *amx, cell *params)
 					{
 						return m->second->priority;
 					}
+					case StreamOutGrace:
+					{
+						return m->second->streamOutGrace;
+					}
 					case Style:
 					{
 						return m->second->style;
@@ -395,6 +403,10 @@ int Manipulation::getIntData(AMX *amx, cell *params)
 					{
 						return t->second->priority;
 					}
+					case StreamOutGrace:
+					{
+						return t->second->streamOutGrace;
+					}
 					case TestLOS:
 					{
 						return t->second->testLOS;
@@ -535,6 +547,10 @@ int Manipulation::getIntData(AMX *amx, cell *params)
 					{
 						return a->second->priority;
 					}
+					case StreamOutGrace:
+					{
+						return a->second->streamOutGrace;
+					}
 					case WorldId:
 					{
 						return Utility::getFirstValueInContainer(a->second->worlds);
@@ -1075,6 +1091,11 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						o->second->priority = static_cast<int>(params[4]);
 						break;
 					}
+					case StreamOutGrace:
+					{
+						o->second->streamOutGrace = static_cast<int>(params[4]);
+						return 1;
+					}
 					case SyncRotation:
 					{
 						if (o->second->attach)
@@ -1123,7 +1144,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 										static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
 										if (native != NULL)
 										{
-											sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
+											Utility::callAttachNative(native, p->first, i->second, j->second, o->second->attach->positionOffset, o->second->attach->rotation, o->second->attach->syncRotation);
 										}
 									}
 								}
@@ -1132,7 +1153,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 									static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
 									if (native != NULL)
 									{
-										sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 1);
+										Utility::callAttachNative(native, p->first, i->second, o->second->attach->player, o->second->attach->positionOffset, o->second->attach->rotation, 1);
 									}
 								}
 								else if (o->second->attach->vehicle != INVALID_VEHICLE_ID)
@@ -1397,6 +1418,11 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						m->second->priority = static_cast<int>(params[4]);
 						return 1;
 					}
+					case StreamOutGrace:
+					{
+						m->second->streamOutGrace = static_cast<int>(params[4]);
+						return 1;
+					}
 					case Style:
 					{
 						m->second->style = static_cast<int>(params[4]);
@@ -1528,6 +1554,11 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						t->second->priority = static_cast<int>(params[4]);
 						return 1;
 					}
+					case StreamOutGrace:
+					{
+						t->second->streamOutGrace = static_cast<int>(params[4]);
+						return 1;
+					}
 					case TestLOS:
 					{
 						t->second->testLOS = static_cast<int>(params[4]) != 0;
@@ -1721,6 +1752,11 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						a->second->priority = static_cast<int>(params[4]);
 						return 1;
 					}
+					case StreamOutGrace:
+					{
+						a->second->streamOutGrace = static_cast<int>(params[4]);
+						return 1;
+					}
 					case WorldId:
 					{
 						return Utility::setFirstValueInContainer(a->second->worlds, static_cast<int>(params[4])) != 0;
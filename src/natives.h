@@ -51,6 +51,35 @@ namespace Natives
 	cell AMX_NATIVE_CALL Streamer_SetCellDistance(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetCellSize(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_SetCellSize(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_ToggleDenseGrid(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsToggleDenseGrid(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_ToggleIncrementalRebuild(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsToggleIncrementalRebuild(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsGridRebuilding(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_FreezeStaticLayer(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetVerticalRanges(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetVerticalRanges(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_ToggleZBanding(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsToggleZBanding(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetWorkerThreads(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetWorkerThreads(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_ToggleStaggeredUpdates(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsToggleStaggeredUpdates(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetTickBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetTickBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetUpdateQueue(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_ToggleSafeDistance(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_IsToggleSafeDistance(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetStreamOutHysteresis(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetStreamOutHysteresis(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetPrefetchUpdates(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetPrefetchUpdates(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetChunkTargetTime(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetChunkTargetTime(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetCreationBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetCreationBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetByteBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetByteBudget(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_ToggleItemStatic(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_IsToggleItemStatic(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_ToggleItemInvAreas(AMX *amx, cell *params);
@@ -70,6 +99,7 @@ namespace Natives
 	cell AMX_NATIVE_CALL Streamer_ToggleItemUpdate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_IsToggleItemUpdate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetLastUpdateTime(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetTickAllocations(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_Update(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_UpdateEx(AMX *amx, cell *params);
 	// Data Manipulation
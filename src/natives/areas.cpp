@@ -367,9 +367,11 @@ cell AMX_NATIVE_CALL Natives::IsPointInDynamicArea(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::IsPointInAnyDynamicArea(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
-	for (std::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
 			return 1;
 		}
@@ -391,9 +393,11 @@ cell AMX_NATIVE_CALL Natives::IsLineInDynamicArea(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::IsLineInAnyDynamicArea(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(6);
-	for (std::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			return 1;
 		}
@@ -485,59 +489,56 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForPoint(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5);
 	std::multimap<float, int> orderedAreas;
-	std::vector<SharedCell> pointCells;
-	core->getGrid()->findMinimalCellsForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointCells);
-	for (std::vector<SharedCell>::const_iterator p = pointCells.begin(); p != pointCells.end(); ++p)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		for (std::unordered_map<int, Item::SharedArea>::const_iterator a = (*p)->areas.begin(); a != (*p)->areas.end(); ++a)
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
-			if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
+			std::variant<Polygon2d, Box2d, Box3d, Eigen::Vector2f, Eigen::Vector3f> position;
+			if ((*a)->attach)
 			{
-				std::variant<Polygon2d, Box2d, Box3d, Eigen::Vector2f, Eigen::Vector3f> position;
-				if (a->second->attach)
+				position = (*a)->position;
+			}
+			else
+			{
+				position = (*a)->position;
+			}
+			float distance = 0.0f;
+			switch ((*a)->type)
+			{
+				case STREAMER_AREA_TYPE_CIRCLE:
+				case STREAMER_AREA_TYPE_CYLINDER:
 				{
-					position = a->second->position;
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), std::get<Eigen::Vector2f>(position)));
+					break;
 				}
-				else
+				case STREAMER_AREA_TYPE_SPHERE:
 				{
-					position = a->second->position;
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), std::get<Eigen::Vector3f>(position)));
+					break;
 				}
-				float distance = 0.0f;
-				switch (a->second->type)
+				case STREAMER_AREA_TYPE_RECTANGLE:
 				{
-					case STREAMER_AREA_TYPE_CIRCLE:
-					case STREAMER_AREA_TYPE_CYLINDER:
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), std::get<Eigen::Vector2f>(position)));
-						break;
-					}
-					case STREAMER_AREA_TYPE_SPHERE:
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), std::get<Eigen::Vector3f>(position)));
-						break;
-					}
-					case STREAMER_AREA_TYPE_RECTANGLE:
-					{
-						Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(std::get<Box2d>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
-						break;
-					}
-					case STREAMER_AREA_TYPE_CUBOID:
-					{
-						Eigen::Vector3f centroid = boost::geometry::return_centroid<Eigen::Vector3f>(std::get<Box3d>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), centroid));
-						break;
+					Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(std::get<Box2d>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
+					break;
+				}
+				case STREAMER_AREA_TYPE_CUBOID:
+				{
+					Eigen::Vector3f centroid = boost::geometry::return_centroid<Eigen::Vector3f>(std::get<Box3d>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), centroid));
+					break;
 
-					}
-					case STREAMER_AREA_TYPE_POLYGON:
-					{
-						Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(std::get<Polygon2d>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
-						break;
-					}
 				}
-				orderedAreas.insert(std::pair<float, int>(distance, a->first));
+				case STREAMER_AREA_TYPE_POLYGON:
+				{
+					Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(std::get<Polygon2d>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
+					break;
+				}
 			}
+			orderedAreas.insert(std::pair<float, int>(distance, (*a)->areaId));
 		}
 	}
 	std::vector<int> finalAreas;
@@ -553,16 +554,13 @@ cell AMX_NATIVE_CALL Natives::GetNumberDynamicAreasForPoint(AMX *amx, cell *para
 {
 	CHECK_PARAMS(3);
 	int areaCount = 0;
-	std::vector<SharedCell> pointCells;
-	core->getGrid()->findMinimalCellsForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointCells);
-	for (std::vector<SharedCell>::const_iterator p = pointCells.begin(); p != pointCells.end(); ++p)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		for (std::unordered_map<int, Item::SharedArea>::const_iterator a = (*p)->areas.begin(); a != (*p)->areas.end(); ++a)
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
-			if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
-			{
-				++areaCount;
-			}
+			++areaCount;
 		}
 	}
 	return static_cast<cell>(areaCount);
@@ -572,21 +570,23 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForLine(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8);
 	std::multimap<float, int> orderedAreas;
-	for (std::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			std::variant<Polygon2d, Box2d, Box3d, Eigen::Vector2f, Eigen::Vector3f> position;
-			if (a->second->attach)
+			if ((*a)->attach)
 			{
-				position = a->second->position;
+				position = (*a)->position;
 			}
 			else
 			{
-				position = a->second->position;
+				position = (*a)->position;
 			}
 			float distance = 0.0f;
-			switch (a->second->type)
+			switch ((*a)->type)
 			{
 				case STREAMER_AREA_TYPE_CIRCLE:
 				case STREAMER_AREA_TYPE_CYLINDER:
@@ -619,7 +619,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForLine(AMX *amx, cell *params)
 					break;
 				}
 			}
-			orderedAreas.insert(std::pair<float, int>(distance, a->first));
+			orderedAreas.insert(std::pair<float, int>(distance, (*a)->areaId));
 		}
 	}
 	std::vector<int> finalAreas;
@@ -635,9 +635,11 @@ cell AMX_NATIVE_CALL Natives::GetNumberDynamicAreasForLine(AMX *amx, cell *param
 {
 	CHECK_PARAMS(6);
 	int areaCount = 0;
-	for (std::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			++areaCount;
 		}
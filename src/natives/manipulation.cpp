@@ -29,6 +29,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetFloatData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetFloatData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	return static_cast<cell>(Manipulation::setFloatData(amx, params));
 }
 
@@ -41,12 +42,19 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetIntData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetIntData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4);
-	return static_cast<cell>(Manipulation::setIntData(amx, params));
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	int result = Manipulation::setIntData(amx, params);
+	if (static_cast<int>(params[3]) == Manipulation::InteriorId || static_cast<int>(params[3]) == Manipulation::WorldId)
+	{
+		core->getGrid()->reassignItem(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	}
+	return static_cast<cell>(result);
 }
 
 cell AMX_NATIVE_CALL Natives::Streamer_RemoveIntData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	return static_cast<cell>(Manipulation::removeIntData(amx, params));
 }
 
@@ -65,7 +73,13 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetArrayData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5);
-	return static_cast<cell>(Manipulation::setArrayData(amx, params));
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	int result = Manipulation::setArrayData(amx, params);
+	if (static_cast<int>(params[3]) == Manipulation::InteriorId || static_cast<int>(params[3]) == Manipulation::WorldId)
+	{
+		core->getGrid()->reassignItem(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	}
+	return static_cast<cell>(result);
 }
 
 cell AMX_NATIVE_CALL Natives::Streamer_IsInArrayData(AMX *amx, cell *params)
@@ -77,13 +91,25 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsInArrayData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_AppendArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4);
-	return static_cast<cell>(Manipulation::appendArrayData(amx, params));
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	int result = Manipulation::appendArrayData(amx, params);
+	if (static_cast<int>(params[3]) == Manipulation::InteriorId || static_cast<int>(params[3]) == Manipulation::WorldId)
+	{
+		core->getGrid()->reassignItem(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	}
+	return static_cast<cell>(result);
 }
 
 cell AMX_NATIVE_CALL Natives::Streamer_RemoveArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4);
-	return static_cast<cell>(Manipulation::removeArrayData(amx, params));
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	int result = Manipulation::removeArrayData(amx, params);
+	if (static_cast<int>(params[3]) == Manipulation::InteriorId || static_cast<int>(params[3]) == Manipulation::WorldId)
+	{
+		core->getGrid()->reassignItem(static_cast<int>(params[1]), static_cast<int>(params[2]));
+	}
+	return static_cast<cell>(result);
 }
 
 cell AMX_NATIVE_CALL Natives::Streamer_GetArrayDataLength(AMX *amx, cell *params)
@@ -201,6 +201,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetDistanceToItem(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItem(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[2]), static_cast<int>(params[3]));
 	switch (static_cast<int>(params[2]))
 	{
 		case STREAMER_TYPE_OBJECT:
@@ -429,6 +430,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsToggleItem(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleAllItems(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5);
+	core->getStreamer()->invalidateSafeDistances();
 	std::unordered_set<int> exceptions;
 	Utility::convertArrayToContainer(amx, params[4], params[5], exceptions);
 	switch (static_cast<int>(params[2]))
@@ -899,6 +901,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsItemVisible(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->invalidateSafeDistances();
 	bool serverWide = static_cast<int>(params[3]) != 0;
 	switch (static_cast<int>(params[2]))
 	{
@@ -929,6 +932,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 				if (serverWide || (a != core->getData()->actors.end() && a->second->amx == amx))
 				{
 					sampgdk::DestroyActor(i->second);
+					core->getStreamer()->eraseActorStreamOutTime(i->first);
 					i = core->getData()->internalActors.erase(i);
 				}
 				else
@@ -954,6 +958,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					{
 						p->second.playerObjectsIndex[i->second] = 0;
 						sampgdk::DestroyPlayerObject(p->first, i->second);
+						p->second.streamOutTimes[STREAMER_TYPE_OBJECT].erase(i->first);
 						i = p->second.internalObjects.erase(i);
 					}
 					else
@@ -1002,6 +1007,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (m != core->getData()->mapIcons.end() && m->second->amx == amx))
 					{
 						sampgdk::RemovePlayerMapIcon(p->first, i->second);
+						p->second.streamOutTimes[STREAMER_TYPE_MAP_ICON].erase(i->first);
 						i = p->second.internalMapIcons.erase(i);
 					}
 					else
@@ -1020,6 +1026,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (t != core->getData()->textLabels.end() && t->second->amx == amx))
 					{
 						sampgdk::DeletePlayer3DTextLabel(p->first, i->second);
+						p->second.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL].erase(i->first);
 						i = p->second.internalTextLabels.erase(i);
 					}
 					else
@@ -1536,6 +1543,17 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetNearbyItems(AMX *amx, cell *params)
 						}
 					}
 				}
+				for (std::vector<Item::FrozenObject>::const_iterator o = (*p)->frozenObjects.begin(); o != (*p)->frozenObjects.end(); ++o)
+				{
+					if (worldId == -1 || o->object->worlds.find(worldId) != o->object->worlds.end())
+					{
+						float distance = static_cast<float>(boost::geometry::comparable_distance(position3d, o->object->position));
+						if (distance < range)
+						{
+							orderedItems.insert(std::pair<float, int>(distance, o->objectId));
+						}
+					}
+				}
 			}
 			break;
 		}
@@ -2038,6 +2056,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemPos(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetItemPos(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	Eigen::Vector3f newpos = Eigen::Vector3f(amx_ctof(params[3]), amx_ctof(params[4]), amx_ctof(params[5]));
 	switch (static_cast<int>(params[1]))
 	{
@@ -2376,6 +2395,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemOffset(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetItemOffset(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	switch (static_cast<int>(params[1]))
 	{
 		case STREAMER_TYPE_OBJECT:
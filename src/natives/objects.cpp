@@ -245,6 +245,7 @@ cell AMX_NATIVE_CALL Natives::ToggleDynamicObjectShootable(AMX *amx, cell *param
 cell AMX_NATIVE_CALL Natives::MoveDynamicObject(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, static_cast<int>(params[1]));
 	if (!amx_ctof(params[5]))
 	{
 		return 0;
@@ -290,6 +291,7 @@ cell AMX_NATIVE_CALL Natives::MoveDynamicObject(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::StopDynamicObject(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(1);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, static_cast<int>(params[1]));
 	std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(static_cast<int>(params[1]));
 	if (o != core->getData()->objects.end())
 	{
@@ -363,6 +365,7 @@ cell AMX_NATIVE_CALL Natives::AttachCameraToDynamicObject(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(9);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, static_cast<int>(params[1]));
 	static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
 	if (native == NULL)
 	{
@@ -394,7 +397,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params
 				{
 					if (native != NULL)
 					{
-						sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
+						Utility::callAttachNative(native, p->first, i->second, j->second, o->second->attach->positionOffset, o->second->attach->rotation, o->second->attach->syncRotation);
 					}
 					for (std::unordered_map<int, Item::Object::Material>::iterator m = o->second->materials.begin(); m != o->second->materials.end(); ++m)
 					{
@@ -441,6 +444,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToPlayer(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, static_cast<int>(params[1]));
 	static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
 	if (native == NULL)
 	{
@@ -468,7 +472,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToPlayer(AMX *amx, cell *params
 			{
 				if (native != NULL)
 				{
-					sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 0);
+					Utility::callAttachNative(native, p->first, i->second, o->second->attach->player, o->second->attach->positionOffset, o->second->attach->rotation, 0);
 				}
 				for (std::unordered_map<int, Item::Object::Material>::iterator m = o->second->materials.begin(); m != o->second->materials.end(); ++m)
 				{
@@ -501,6 +505,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToPlayer(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToVehicle(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_OBJECT, static_cast<int>(params[1]));
 	std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(static_cast<int>(params[1]));
 	if (o != core->getData()->objects.end())
 	{
@@ -628,6 +633,7 @@ cell AMX_NATIVE_CALL Natives::RemoveDynamicObjectMaterial(AMX *amx, cell *params
 				{
 					p->second.playerObjectsIndex[i->second] = 0;
 					sampgdk::DestroyPlayerObject(p->first, i->second);
+					p->second.streamOutTimes[STREAMER_TYPE_OBJECT].erase(i->first);
 					p->second.internalObjects.erase(i);
 					core->getStreamer()->startManualUpdate(p->second, STREAMER_TYPE_OBJECT);
 				}
@@ -723,6 +729,7 @@ cell AMX_NATIVE_CALL Natives::RemoveDynamicObjectMaterialText(AMX *amx, cell *pa
 				{
 					p->second.playerObjectsIndex[i->second] = 0;
 					sampgdk::DestroyPlayerObject(p->first, i->second);
+					p->second.streamOutTimes[STREAMER_TYPE_OBJECT].erase(i->first);
 					p->second.internalObjects.erase(i);
 					core->getStreamer()->startManualUpdate(p->second, STREAMER_TYPE_OBJECT);
 				}
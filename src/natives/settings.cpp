@@ -49,6 +49,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetPlayerTickRate(AMX *amx, cell *params)
 	if (p != core->getData()->players.end())
 	{
 		p->second.tickRate = static_cast<std::size_t>(params[2]);
+		p->second.tickCount = static_cast<std::size_t>(p->first) % std::max(p->second.tickRate, static_cast<std::size_t>(1));
 		return 1;
 	}
 	return 0;
@@ -57,6 +58,23 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetPlayerTickRate(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleChunkStream(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(1);
+	core->getStreamer()->invalidateSafeDistances();
+	if (!static_cast<int>(params[1]))
+	{
+		for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+		{
+			p->second.discoveredMapIcons.clear();
+			p->second.discoveredObjects.clear();
+			p->second.discoveredTextLabels.clear();
+			p->second.existingMapIcons.clear();
+			p->second.existingObjects.clear();
+			p->second.existingTextLabels.clear();
+			p->second.removedMapIcons.clear();
+			p->second.removedObjects.clear();
+			p->second.removedTextLabels.clear();
+			p->second.processingChunks.reset();
+		}
+	}
 	core->getChunkStreamer()->setChunkStreamingEnabled(static_cast<int>(params[1]) != 0);
 	return 1;
 }
@@ -111,6 +129,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetMaxItems(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetMaxItems(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(2);
+	core->getStreamer()->invalidateSafeDistances();
 	return static_cast<cell>(core->getData()->setGlobalMaxItems(static_cast<int>(params[1]), static_cast<std::size_t>(params[2])) != 0);
 }
 
@@ -123,6 +142,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetVisibleItems(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetVisibleItems(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->invalidateSafeDistances();
 	return static_cast<cell>(Utility::setMaxVisibleItems(static_cast<int>(params[1]), static_cast<std::size_t>(params[2]), static_cast<int>(params[3])) != 0);
 }
 
@@ -137,6 +157,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetRadiusMultiplier(AMX *amx, cell *param
 cell AMX_NATIVE_CALL Natives::Streamer_SetRadiusMultiplier(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->invalidateSafeDistances();
 	return static_cast<cell>(Utility::setRadiusMultiplier(static_cast<int>(params[1]), amx_ctof(params[2]), static_cast<int>(params[3])) != 0);
 }
 
@@ -184,9 +205,242 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetCellSize(AMX *amx, cell *params)
 	return 1;
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_ToggleDenseGrid(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	core->getGrid()->setDenseGrid(static_cast<int>(params[1]) != 0, amx_ctof(params[2]));
+	core->getGrid()->rebuildGrid();
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsToggleDenseGrid(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getGrid()->isDenseGridEnabled());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_ToggleIncrementalRebuild(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	if (static_cast<int>(params[2]) <= 0)
+	{
+		Utility::logError("Streamer_ToggleIncrementalRebuild: Invalid number of items per tick specified.");
+		return 0;
+	}
+	core->getGrid()->setIncrementalRebuild(static_cast<int>(params[1]) != 0, static_cast<std::size_t>(params[2]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsToggleIncrementalRebuild(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getGrid()->isIncrementalRebuildEnabled());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsGridRebuilding(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getGrid()->isRebuilding());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_FreezeStaticLayer(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getGrid()->freezeStaticLayer());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetVerticalRanges(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	std::tuple<float, float> verticalRanges = core->getStreamer()->getVerticalRanges();
+	Utility::storeFloatInNative(amx, params[1], std::get<0>(verticalRanges));
+	Utility::storeFloatInNative(amx, params[2], std::get<1>(verticalRanges));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetVerticalRanges(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	core->getStreamer()->invalidateSafeDistances();
+	core->getStreamer()->setVerticalRanges(amx_ctof(params[1]), amx_ctof(params[2]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_ToggleZBanding(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	core->getGrid()->setZBanding(static_cast<int>(params[1]) != 0, amx_ctof(params[2]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsToggleZBanding(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getGrid()->isZBandingEnabled());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetWorkerThreads(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getWorkerThreads());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetWorkerThreads(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	if (static_cast<int>(params[1]) <= 0 || static_cast<int>(params[1]) > STREAMER_MAX_WORKER_THREADS)
+	{
+		Utility::logError("Streamer_SetWorkerThreads: Invalid number of threads specified.");
+		return 0;
+	}
+	return static_cast<cell>(core->getStreamer()->setWorkerThreads(static_cast<std::size_t>(params[1])));
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_ToggleStaggeredUpdates(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	core->getStreamer()->setStaggeredUpdates(static_cast<int>(params[1]) != 0);
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsToggleStaggeredUpdates(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getStaggeredUpdates());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetTickBudget(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getTickBudget());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetTickBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	if (static_cast<int>(params[1]) < 0)
+	{
+		Utility::logError("Streamer_SetTickBudget: Invalid budget specified.");
+		return 0;
+	}
+	core->getStreamer()->setTickBudget(static_cast<std::size_t>(params[1]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetUpdateQueue(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	Utility::storeIntegerInNative(amx, params[1], static_cast<int>(core->getStreamer()->getUpdateQueueSize()));
+	Utility::storeFloatInNative(amx, params[2], core->getStreamer()->getUpdateQueueDelay());
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_ToggleSafeDistance(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	core->getStreamer()->setSafeDistanceSkip(static_cast<int>(params[1]) != 0);
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_IsToggleSafeDistance(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getSafeDistanceSkip());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetStreamOutHysteresis(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	Utility::storeFloatInNative(amx, params[1], std::get<0>(core->getStreamer()->getStreamOutHysteresis()));
+	Utility::storeIntegerInNative(amx, params[2], std::get<1>(core->getStreamer()->getStreamOutHysteresis()));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetStreamOutHysteresis(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2);
+	if (amx_ctof(params[1]) < 0.0f || static_cast<int>(params[2]) < 0)
+	{
+		Utility::logError("Streamer_SetStreamOutHysteresis: Invalid margin or grace period specified.");
+		return 0;
+	}
+	core->getStreamer()->setStreamOutHysteresis(amx_ctof(params[1]), static_cast<int>(params[2]));
+	core->getStreamer()->invalidateSafeDistances();
+	for (std::unordered_map<int, Item::SharedActor>::iterator a = core->getData()->actors.begin(); a != core->getData()->actors.end(); ++a)
+	{
+		core->getGrid()->removeActor(a->second, true);
+	}
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetPrefetchUpdates(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getPrefetchUpdates());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetPrefetchUpdates(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	if (static_cast<int>(params[1]) < 0)
+	{
+		Utility::logError("Streamer_SetPrefetchUpdates: Invalid number of updates specified.");
+		return 0;
+	}
+	core->getStreamer()->setPrefetchUpdates(static_cast<std::size_t>(params[1]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetChunkTargetTime(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(3);
+	std::tuple<float, std::size_t, std::size_t> chunkTarget = core->getChunkStreamer()->getChunkTarget();
+	Utility::storeFloatInNative(amx, params[1], std::get<0>(chunkTarget));
+	Utility::storeIntegerInNative(amx, params[2], static_cast<int>(std::get<1>(chunkTarget)));
+	Utility::storeIntegerInNative(amx, params[3], static_cast<int>(std::get<2>(chunkTarget)));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetChunkTargetTime(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(3);
+	if (amx_ctof(params[1]) < 0.0f || static_cast<int>(params[2]) <= 0 || static_cast<int>(params[3]) < static_cast<int>(params[2]))
+	{
+		Utility::logError("Streamer_SetChunkTargetTime: Invalid target time or chunk size limits specified.");
+		return 0;
+	}
+	core->getChunkStreamer()->setChunkTarget(amx_ctof(params[1]), static_cast<std::size_t>(params[2]), static_cast<std::size_t>(params[3]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetCreationBudget(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getCreationBudget());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetCreationBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	if (static_cast<int>(params[1]) < 0)
+	{
+		Utility::logError("Streamer_SetCreationBudget: Invalid budget specified.");
+		return 0;
+	}
+	core->getStreamer()->setCreationBudget(static_cast<std::size_t>(params[1]));
+	return 1;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetByteBudget(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getByteBudget());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetByteBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1);
+	if (static_cast<int>(params[1]) < 0)
+	{
+		Utility::logError("Streamer_SetByteBudget: Invalid budget specified.");
+		return 0;
+	}
+	core->getStreamer()->setByteBudget(static_cast<std::size_t>(params[1]));
+	return 1;
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItemStatic(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	switch (static_cast<int>(params[1]))
 	{
 		case STREAMER_TYPE_OBJECT:
@@ -474,6 +728,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsToggleItemStatic(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItemInvAreas(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->markItemDirty(static_cast<int>(params[1]), static_cast<int>(params[2]));
 	switch (static_cast<int>(params[1]))
 	{
 		case STREAMER_TYPE_OBJECT:
@@ -103,6 +103,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamic3DTextLabelText(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::UpdateDynamic3DTextLabelText(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->markItemDirty(STREAMER_TYPE_3D_TEXT_LABEL, static_cast<int>(params[1]));
 	std::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(static_cast<int>(params[1]));
 	if (t != core->getData()->textLabels.end())
 	{
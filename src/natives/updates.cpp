@@ -74,12 +74,17 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsToggleCameraUpdate(AMX *amx, cell *para
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItemUpdate(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3);
+	core->getStreamer()->invalidateSafeDistances();
 	std::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
 	if (p != core->getData()->players.end())
 	{
 		if (static_cast<int>(params[2]) >= 0 && static_cast<int>(params[2]) < STREAMER_MAX_TYPES)
 		{
 			p->second.enabledItems.set(static_cast<size_t>(params[2]), params[3] != 0);
+			if (!params[3])
+			{
+				p->second.streamOutTimes[static_cast<int>(params[2])].clear();
+			}
 			return 1;
 		}
 	}
@@ -107,6 +112,11 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetLastUpdateTime(AMX *amx, cell *params)
 	return 1;
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_GetTickAllocations(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getTickAllocations());
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_Update(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(2);
@@ -29,6 +29,7 @@ Player::Player(int id)
 	chunkTickRate[STREAMER_TYPE_OBJECT] = 1;
 	chunkTickRate[STREAMER_TYPE_MAP_ICON] = 1;
 	chunkTickRate[STREAMER_TYPE_3D_TEXT_LABEL] = 1;
+	creationBacklog = false;
 	currentVisibleObjects = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_OBJECT);
 	currentVisibleTextLabels = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_3D_TEXT_LABEL);
 	delayedCheckpoint = 0;
@@ -47,12 +48,20 @@ Player::Player(int id)
 	{
 		enabledItems.set();
 	}
+	dirtyItemsIndex = 0;
 	interiorId = 0;
 	maxVisibleMapIcons = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_MAP_ICON);
 	maxVisibleObjects = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_OBJECT);
 	maxVisibleTextLabels = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_3D_TEXT_LABEL);
+	neighbouringCellsVersion = 0;
+	neighbouringCellsStale = true;
+	neighbouringInteriorId = 0;
+	neighbouringWorldId = 0;
+	neighbouringZBand = 0;
+	outsideCell = std::make_shared<Cell>();
 	playerId = id;
 	position.setZero();
+	prefetchOffset.setZero();
 	radiusMultipliers[STREAMER_TYPE_OBJECT] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_OBJECT);
 	radiusMultipliers[STREAMER_TYPE_PICKUP] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_PICKUP);
 	radiusMultipliers[STREAMER_TYPE_CP] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_CP);
@@ -62,8 +71,12 @@ Player::Player(int id)
 	radiusMultipliers[STREAMER_TYPE_AREA] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_AREA);
 	radiusMultipliers[STREAMER_TYPE_ACTOR] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_ACTOR);
 	requestingClass = false;
-	tickCount = 0;
+	safeDistance = 0.0f;
+	safeItemVersion = 0;
+	safePosition.setZero();
+	scratchCapacity = 0;
 	tickRate = 50;
+	tickCount = static_cast<std::size_t>(id) % tickRate;
 	updateUsingCameraPosition = false;
 	updateWhenIdle = false;
 	visibleCell = std::make_shared<Cell>();
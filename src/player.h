@@ -28,6 +28,7 @@ struct Player
 	int activeRaceCheckpoint;
 	std::size_t chunkTickCount[STREAMER_MAX_TYPES];
 	std::size_t chunkTickRate[STREAMER_MAX_TYPES];
+	bool creationBacklog;
 	std::size_t currentVisibleObjects;
 	std::size_t currentVisibleTextLabels;
 	int playerObjectsIndex[MAX_OBJECTS];
@@ -38,6 +39,7 @@ struct Player
 	bool delayedUpdateFreeze;
 	std::chrono::steady_clock::time_point delayedUpdateTime;
 	int delayedUpdateType;
+	std::size_t dirtyItemsIndex;
 	int selectObject;
 	int interiorId;
 	std::size_t maxVisibleMapIcons;
@@ -45,9 +47,22 @@ struct Player
 	std::size_t maxVisibleTextLabels;
 	int playerId;
 	Eigen::Vector3f position;
+	Eigen::Vector3f prefetchOffset;
+	CellId neighbouringCellId;
+	std::size_t neighbouringCellsVersion;
+	bool neighbouringCellsStale;
+	int neighbouringInteriorId;
+	int neighbouringWorldId;
+	int neighbouringZBand;
+	SharedCell outsideCell;
 	float radiusMultipliers[STREAMER_MAX_TYPES];
 	int references;
 	bool requestingClass;
+	float safeDistance;
+	std::size_t safeItemVersion;
+	Eigen::Vector3f safePosition;
+	std::size_t scratchCapacity;
+	std::unordered_map<int, std::chrono::steady_clock::time_point> streamOutTimes[STREAMER_MAX_TYPES];
 	std::size_t tickCount;
 	std::size_t tickRate;
 	bool updateUsingCameraPosition;
@@ -69,6 +84,10 @@ struct Player
 	Item::Bimap<Item::SharedObject>::Type existingObjects;
 	Item::Bimap<Item::SharedTextLabel>::Type existingTextLabels;
 
+	std::vector<SharedCell> neighbouringCells;
+	std::vector<SharedCell> scratchCells;
+	std::vector<Cell*> updateCells;
+
 	std::unordered_set<int> internalAreas;
 	std::unordered_map<int, int> internalMapIcons;
 	std::unordered_map<int, int> internalObjects;
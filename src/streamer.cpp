@@ -27,6 +27,86 @@ Streamer::Streamer()
 	tickRate = 50;
 	eServerTickRate = 0;
 	velocityBoundaries = std::make_tuple(0.25f, 7.5f);
+	verticalRanges = std::make_tuple(500.0f, 400.0f);
+	workerThreads = 1;
+	staggeredUpdates = false;
+	tickBudget = 0;
+	safeDistanceSkip = false;
+	itemVersion = 0;
+	streamOutMargin = 0.0f;
+	streamOutGrace = 0;
+	prefetchUpdates = 0;
+	creationBudget = 0;
+	byteBudget = 0;
+	creationBytes = std::numeric_limits<std::size_t>::max();
+	dirtyItemsBase = 0;
+	scratchCapacity = 0;
+	tickAllocations = 0;
+	workerIndex = 0;
+	workerGeneration = 0;
+	workerJobs = 0;
+	workerPending = 0;
+	workerShutdown = false;
+}
+
+Streamer::~Streamer()
+{
+	stopWorkers();
+}
+
+bool Streamer::setWorkerThreads(std::size_t value)
+{
+	if (value > 0 && value <= STREAMER_MAX_WORKER_THREADS)
+	{
+		stopWorkers();
+		workerThreads = value;
+		std::lock_guard<std::mutex> lock(workerMutex);
+		for (std::size_t i = 1; i < workerThreads; ++i)
+		{
+			workers.push_back(std::thread(&Streamer::runWorker, this, workerGeneration));
+		}
+		return true;
+	}
+	return false;
+}
+
+void Streamer::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		workerShutdown = true;
+	}
+	workerStart.notify_all();
+	for (std::vector<std::thread>::iterator w = workers.begin(); w != workers.end(); ++w)
+	{
+		w->join();
+	}
+	workers.clear();
+	workerShutdown = false;
+}
+
+void Streamer::runWorker(std::size_t generation)
+{
+	std::unique_lock<std::mutex> lock(workerMutex);
+	while (true)
+	{
+		while (!workerShutdown && workerGeneration == generation)
+		{
+			workerStart.wait(lock);
+		}
+		if (workerShutdown)
+		{
+			return;
+		}
+		generation = workerGeneration;
+		lock.unlock();
+		discoverPlayerUpdates(workerJobs, workerIndex);
+		lock.lock();
+		if (!--workerPending)
+		{
+			workerDone.notify_one();
+		}
+	}
 }
 
 void Streamer::calculateAverageElapsedTime()
@@ -52,39 +132,126 @@ void Streamer::calculateAverageElapsedTime()
 
 void Streamer::startAutomaticUpdate()
 {
-	if (++tickCount >= tickRate)
+	bool globalUpdate = ++tickCount >= tickRate;
+	if (globalUpdate || staggeredUpdates || !updateQueue.empty())
 	{
+		if (globalUpdate)
+		{
+			core->getGrid()->processIncrementalRebuild();
+		}
 		if (!core->getData()->interfaces.empty())
 		{
 			std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
 
-			processActiveItems();
-			
-			for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+			if (globalUpdate)
+			{
+				processActiveItems();
+			}
+
+			if (tickBudget)
 			{
-				if (!p->second.delayedUpdate)
+				for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 				{
-					performPlayerUpdate(p->second, true);
+					if (isPlayerUpdateDue(p->second, globalUpdate) && queuedPlayers.insert(p->first).second)
+					{
+						updateQueue.push_back(std::make_pair(p->first, currentTime));
+					}
 				}
-				else
+				processUpdateQueue(currentTime);
+			}
+			else if (workerThreads > 1 && core->getData()->players.size() > 1)
+			{
+				performParallelPlayerUpdates(globalUpdate);
+			}
+			else
+			{
+				for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 				{
-					startManualUpdate(p->second, p->second.delayedUpdateType);
+					if (!isPlayerUpdateDue(p->second, globalUpdate))
+					{
+						continue;
+					}
+					if (!p->second.delayedUpdate)
+					{
+						performPlayerUpdate(p->second, true);
+					}
+					else
+					{
+						startManualUpdate(p->second, p->second.delayedUpdateType);
+					}
 				}
 			}
-			if (!core->getData()->players.empty())
+			if (globalUpdate && !core->getData()->players.empty())
 			{
 				streamPickups();
 				streamActors();
 			}
+			if (!dirtyItems.empty())
+			{
+				trimDirtyItems();
+			}
+			trackScratchAllocations();
 			executeCallbacks();
 
-			calculateAverageElapsedTime();
-			lastUpdateTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - currentTime).count();
+			if (globalUpdate)
+			{
+				calculateAverageElapsedTime();
+				lastUpdateTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - currentTime).count();
+				if (core->getChunkStreamer()->getChunkStreamingEnabled())
+				{
+					core->getChunkStreamer()->adjustChunkSizes(lastUpdateTime);
+				}
+			}
+		}
+		if (globalUpdate)
+		{
+			tickCount = 0;
+		}
+	}
+}
+
+void Streamer::processUpdateQueue(const std::chrono::steady_clock::time_point &startTime)
+{
+	bool processed = false;
+	while (!updateQueue.empty())
+	{
+		if (processed && std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count() >= static_cast<long long>(tickBudget))
+		{
+			break;
+		}
+		int playerId = updateQueue.front().first;
+		updateQueue.pop_front();
+		queuedPlayers.erase(playerId);
+		std::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerId);
+		if (p != core->getData()->players.end())
+		{
+			if (!p->second.delayedUpdate)
+			{
+				performPlayerUpdate(p->second, true);
+			}
+			else
+			{
+				startManualUpdate(p->second, p->second.delayedUpdateType);
+			}
+			processed = true;
 		}
-		tickCount = 0;
 	}
 }
 
+bool Streamer::isPlayerUpdateDue(Player &player, bool globalUpdate)
+{
+	if (!staggeredUpdates)
+	{
+		return globalUpdate;
+	}
+	if (++player.tickCount >= std::max<std::size_t>(player.tickRate, 1))
+	{
+		player.tickCount = 0;
+		return true;
+	}
+	return false;
+}
+
 void Streamer::startManualUpdate(Player &player, int type)
 {
 	std::bitset<STREAMER_MAX_TYPES> enabledItems = player.enabledItems;
@@ -112,8 +279,83 @@ void Streamer::startManualUpdate(Player &player, int type)
 
 void Streamer::performPlayerUpdate(Player &player, bool automatic)
 {
-	Eigen::Vector3f delta = Eigen::Vector3f::Zero(), position = player.position;
-	bool update = true;
+	PlayerUpdate playerUpdate;
+	playerUpdate.player = &player;
+	playerUpdate.cells.swap(player.updateCells);
+	preparePlayerUpdate(playerUpdate, automatic);
+	discoverPlayerUpdate(playerUpdate, false);
+	applyPlayerUpdate(playerUpdate, automatic);
+	player.updateCells.swap(playerUpdate.cells);
+}
+
+void Streamer::performParallelPlayerUpdates(bool globalUpdate)
+{
+	std::size_t count = 0;
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		if (!isPlayerUpdateDue(p->second, globalUpdate))
+		{
+			continue;
+		}
+		if (!p->second.delayedUpdate)
+		{
+			if (count == playerUpdates.size())
+			{
+				playerUpdates.push_back(PlayerUpdate());
+			}
+			playerUpdates[count].player = &p->second;
+			preparePlayerUpdate(playerUpdates[count++], true);
+		}
+		else
+		{
+			startManualUpdate(p->second, p->second.delayedUpdateType);
+		}
+	}
+	workerIndex = 0;
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		workerJobs = count;
+		workerPending = workers.size();
+		++workerGeneration;
+	}
+	workerStart.notify_all();
+	discoverPlayerUpdates(count, workerIndex);
+	{
+		std::unique_lock<std::mutex> lock(workerMutex);
+		while (workerPending)
+		{
+			workerDone.wait(lock);
+		}
+	}
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		applyPlayerUpdate(playerUpdates[i], true);
+	}
+}
+
+void Streamer::discoverPlayerUpdates(std::size_t count, std::atomic<std::size_t> &index)
+{
+	for (std::size_t i = index++; i < count; i = index++)
+	{
+		discoverPlayerUpdate(playerUpdates[i], true);
+	}
+}
+
+void Streamer::preparePlayerUpdate(PlayerUpdate &playerUpdate, bool automatic)
+{
+	Player &player = *playerUpdate.player;
+	Eigen::Vector3f &delta = playerUpdate.delta, &position = playerUpdate.position;
+	bool &update = playerUpdate.update;
+	delta = Eigen::Vector3f::Zero();
+	position = player.position;
+	update = true;
+	playerUpdate.automatic = automatic;
+	playerUpdate.idle = false;
+	player.prefetchOffset.setZero();
+	if (!automatic)
+	{
+		player.safeDistance = 0.0f;
+	}
 	if (automatic)
 	{
 		player.interiorId = sampgdk::GetPlayerInterior(player.playerId);
@@ -147,11 +389,20 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 					if (velocityNorm > std::get<0>(velocityBoundaries) && velocityNorm < std::get<1>(velocityBoundaries))
 					{
 						delta = velocity * averageElapsedTime;
+						if (staggeredUpdates)
+						{
+							delta *= static_cast<float>(std::max<std::size_t>(player.tickRate, 1)) / static_cast<float>(tickRate);
+						}
+						if (prefetchUpdates)
+						{
+							player.prefetchOffset = delta * static_cast<float>(prefetchUpdates);
+						}
 					}
 				}
 				else
 				{
-					update = player.updateWhenIdle;
+					update = player.updateWhenIdle || player.creationBacklog || player.dirtyItemsIndex < dirtyItemsBase;
+					playerUpdate.idle = true;
 				}
 			}
 			else
@@ -192,30 +443,120 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 			player.delayedRaceCheckpoint = 0;
 		}
 	}
-	std::vector<SharedCell> cells;
-	if (update)
+}
+
+void Streamer::discoverPlayerUpdate(PlayerUpdate &playerUpdate, bool objects)
+{
+	Player &player = *playerUpdate.player;
+	playerUpdate.cells.clear();
+	if (playerUpdate.update)
 	{
-		core->getGrid()->findAllCellsForPlayer(player, cells);
+		core->getGrid()->findAllCellsForPlayer(player, playerUpdate.cells);
 	}
 	else
 	{
-		core->getGrid()->findMinimalCellsForPlayer(player, cells);
+		core->getGrid()->findMinimalCellsForPlayer(player, playerUpdate.cells);
+	}
+	if (playerUpdate.update && !player.prefetchOffset.isZero())
+	{
+		player.position += playerUpdate.delta;
+		core->getGrid()->findPrefetchCellsForPlayer(player, player.prefetchOffset, playerUpdate.cells);
+		player.position = playerUpdate.position;
+	}
+	bool chunked = playerUpdate.automatic && core->getChunkStreamer()->getChunkStreamingEnabled();
+	playerUpdate.withinSafeDistance = false;
+	if (safeDistanceSkip && !chunked && playerUpdate.automatic && playerUpdate.update && player.prefetchOffset.isZero() && !playerUpdate.cells.empty())
+	{
+		Eigen::Vector3f position = player.position + playerUpdate.delta;
+		if (player.safeItemVersion == itemVersion && player.dirtyItemsIndex >= dirtyItemsBase && player.streamOutTimes[STREAMER_TYPE_OBJECT].empty() && player.streamOutTimes[STREAMER_TYPE_MAP_ICON].empty() && player.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL].empty() && boost::geometry::comparable_distance(position, player.safePosition) < (player.safeDistance * player.safeDistance))
+		{
+			playerUpdate.withinSafeDistance = true;
+		}
+		else
+		{
+			player.safeDistance = std::numeric_limits<float>::infinity();
+			player.safeItemVersion = itemVersion;
+			player.safePosition = position;
+		}
+	}
+	playerUpdate.objectsDiscovered = false;
+	if (objects && !chunked && playerUpdate.update && !playerUpdate.withinSafeDistance && !playerUpdate.cells.empty() && !core->getData()->objects.empty() && player.enabledItems[STREAMER_TYPE_OBJECT])
+	{
+		player.position += playerUpdate.delta;
+		playerUpdate.discoveredObjects.clear();
+		playerUpdate.existingObjects.clear();
+		playerUpdate.removedObjects.clear();
+		playerUpdate.prefetchedObjects.clear();
+		discoverObjects(player, playerUpdate.cells, playerUpdate.discoveredObjects, playerUpdate.existingObjects, playerUpdate.removedObjects, playerUpdate.prefetchedObjects);
+		player.position = playerUpdate.position;
+		playerUpdate.objectsDiscovered = true;
 	}
+}
+
+void Streamer::applyPlayerUpdate(PlayerUpdate &playerUpdate, bool automatic)
+{
+	Player &player = *playerUpdate.player;
+	const std::vector<Cell*> &cells = playerUpdate.cells;
+	const Eigen::Vector3f &delta = playerUpdate.delta, &position = playerUpdate.position;
+	bool update = playerUpdate.update, evaluate = update && !playerUpdate.withinSafeDistance;
+	ChunkStreamer *chunkStreamer = automatic && core->getChunkStreamer()->getChunkStreamingEnabled() ? core->getChunkStreamer() : NULL;
+	bool budgeted = creationBudget && evaluate && !chunkStreamer;
+	creationBytes = byteBudget && evaluate && !chunkStreamer ? byteBudget : std::numeric_limits<std::size_t>::max();
 	if (!cells.empty())
 	{
 		if (!delta.isZero())
 		{
 			player.position += delta;
 		}
+		int delayedCheckpoint = player.delayedCheckpoint, delayedRaceCheckpoint = player.delayedRaceCheckpoint;
+		if (evaluate)
+		{
+			player.creationBacklog = false;
+		}
+		if (budgeted)
+		{
+			discoveredMapIcons.clear();
+			existingMapIcons.clear();
+			discoveredObjects.clear();
+			existingObjects.clear();
+			removedObjects.clear();
+			prefetchedObjects.clear();
+			discoveredTextLabels.clear();
+			existingTextLabels.clear();
+		}
 		for (std::vector<int>::const_iterator t = core->getData()->typePriority.begin(); t != core->getData()->typePriority.end(); ++t)
 		{
 			switch (*t)
 			{
 				case STREAMER_TYPE_OBJECT:
 				{
-					if (update && !core->getData()->objects.empty() && player.enabledItems[STREAMER_TYPE_OBJECT])
+					if (chunkStreamer)
+					{
+						if (evaluate && !core->getData()->objects.empty() && player.enabledItems[STREAMER_TYPE_OBJECT])
+						{
+							player.discoveredObjects.clear();
+							player.existingObjects.clear();
+							player.removedObjects.clear();
+							chunkStreamer->discoverObjects(player, cells);
+						}
+					}
+					else if (playerUpdate.objectsDiscovered)
 					{
-						processObjects(player, cells);
+						if (!budgeted)
+						{
+							streamObjects(player, playerUpdate.discoveredObjects, playerUpdate.existingObjects, playerUpdate.removedObjects, playerUpdate.prefetchedObjects);
+						}
+					}
+					else if (evaluate && !core->getData()->objects.empty() && player.enabledItems[STREAMER_TYPE_OBJECT])
+					{
+						if (budgeted)
+						{
+							discoverObjects(player, cells, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+						}
+						else
+						{
+							processObjects(player, cells);
+						}
 					}
 					break;
 				}
@@ -253,17 +594,45 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 				}
 				case STREAMER_TYPE_MAP_ICON:
 				{
-					if (update && !core->getData()->mapIcons.empty() && player.enabledItems[STREAMER_TYPE_MAP_ICON])
+					if (evaluate && !core->getData()->mapIcons.empty() && player.enabledItems[STREAMER_TYPE_MAP_ICON])
 					{
-						processMapIcons(player, cells);
+						if (chunkStreamer)
+						{
+							player.discoveredMapIcons.clear();
+							player.existingMapIcons.clear();
+							player.removedMapIcons.clear();
+							chunkStreamer->discoverMapIcons(player, cells);
+						}
+						else if (budgeted)
+						{
+							discoverMapIcons(player, cells);
+						}
+						else
+						{
+							processMapIcons(player, cells);
+						}
 					}
 					break;
 				}
 				case STREAMER_TYPE_3D_TEXT_LABEL:
 				{
-					if (update && !core->getData()->textLabels.empty() && player.enabledItems[STREAMER_TYPE_3D_TEXT_LABEL])
+					if (evaluate && !core->getData()->textLabels.empty() && player.enabledItems[STREAMER_TYPE_3D_TEXT_LABEL])
 					{
-						processTextLabels(player, cells);
+						if (chunkStreamer)
+						{
+							player.discoveredTextLabels.clear();
+							player.existingTextLabels.clear();
+							player.removedTextLabels.clear();
+							chunkStreamer->discoverTextLabels(player, cells);
+						}
+						else if (budgeted)
+						{
+							discoverTextLabels(player, cells);
+						}
+						else
+						{
+							processTextLabels(player, cells);
+						}
 					}
 					break;
 				}
@@ -285,107 +654,329 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 				}
 			}
 		}
+		if (budgeted)
+		{
+			std::size_t checkpoints = static_cast<std::size_t>(player.delayedCheckpoint && player.delayedCheckpoint != delayedCheckpoint) + static_cast<std::size_t>(player.delayedRaceCheckpoint && player.delayedRaceCheckpoint != delayedRaceCheckpoint);
+			streamBudgetedItems(playerUpdate, creationBudget - std::min(creationBudget, checkpoints));
+		}
+		if (!evaluate && (playerUpdate.withinSafeDistance || playerUpdate.idle) && player.dirtyItemsIndex < (dirtyItemsBase + dirtyItems.size()))
+		{
+			processDirtyItems(player);
+		}
+		if (chunkStreamer && player.processingChunks.any())
+		{
+			Streamer *source = chunkStreamer;
+			chunkStreamer->performPlayerChunkUpdate(player, true);
+			streamInCallbacks.insert(streamInCallbacks.end(), source->streamInCallbacks.begin(), source->streamInCallbacks.end());
+			streamOutCallbacks.insert(streamOutCallbacks.end(), source->streamOutCallbacks.begin(), source->streamOutCallbacks.end());
+			source->streamInCallbacks.clear();
+			source->streamOutCallbacks.clear();
+		}
 		if (!delta.isZero())
 		{
 			player.position = position;
 		}
 	}
+	player.dirtyItemsIndex = dirtyItemsBase + dirtyItems.size();
 }
 
-void Streamer::executeCallbacks()
+void Streamer::markItemDirty(int type, int id)
 {
-	if (!areaLeaveCallbacks.empty())
+	if (type == STREAMER_TYPE_OBJECT)
+	{
+		core->getGrid()->thawObject(id);
+	}
+	if (type != STREAMER_TYPE_OBJECT && type != STREAMER_TYPE_MAP_ICON && type != STREAMER_TYPE_3D_TEXT_LABEL)
+	{
+		return;
+	}
+	if (dirtyItems.size() >= STREAMER_MAX_DIRTY_ITEMS)
 	{
-		std::multimap<int, std::tuple<int, int> > callbacks;
-		std::swap(areaLeaveCallbacks, callbacks);
-		for (std::multimap<int, std::tuple<int, int> >::reverse_iterator c = callbacks.rbegin(); c != callbacks.rend(); ++c)
+		dirtyItemsBase += dirtyItems.size();
+		dirtyItems.clear();
+	}
+	dirtyItems.push_back(std::make_pair(type, id));
+}
+
+void Streamer::processDirtyItems(Player &player)
+{
+	float safeDistance = player.safeDistance;
+	player.safeDistance = std::numeric_limits<float>::infinity();
+	discoveredMapIcons.clear();
+	existingMapIcons.clear();
+	discoveredObjects.clear();
+	existingObjects.clear();
+	removedObjects.clear();
+	prefetchedObjects.clear();
+	discoveredTextLabels.clear();
+	existingTextLabels.clear();
+	for (std::deque<std::pair<int, int> >::const_iterator d = dirtyItems.begin() + (std::max(player.dirtyItemsIndex, dirtyItemsBase) - dirtyItemsBase); d != dirtyItems.end(); ++d)
+	{
+		if (!player.enabledItems[d->first])
 		{
-			std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(std::get<0>(c->second));
-			if (a != core->getData()->areas.end())
+			continue;
+		}
+		switch (d->first)
+		{
+			case STREAMER_TYPE_OBJECT:
 			{
-				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(d->second);
+				if (o != core->getData()->objects.end())
 				{
-					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnPlayerLeaveDynamicArea", &amxIndex))
-					{
-						amx_Push(*i, static_cast<cell>(std::get<0>(c->second)));
-						amx_Push(*i, static_cast<cell>(std::get<1>(c->second)));
-						amx_Exec(*i, NULL, amxIndex);
-					}
+					discoverObject(player, o->second, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
 				}
+				break;
 			}
-		}
-	}
-	if (!areaEnterCallbacks.empty())
-	{
-		std::multimap<int, std::tuple<int, int> > callbacks;
-		std::swap(areaEnterCallbacks, callbacks);
-		for (std::multimap<int, std::tuple<int, int> >::reverse_iterator c = callbacks.rbegin(); c != callbacks.rend(); ++c)
-		{
-			std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(std::get<0>(c->second));
-			if (a != core->getData()->areas.end())
+			case STREAMER_TYPE_MAP_ICON:
 			{
-				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				std::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(d->second);
+				if (m != core->getData()->mapIcons.end())
 				{
-					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnPlayerEnterDynamicArea", &amxIndex))
-					{
-						amx_Push(*i, static_cast<cell>(std::get<0>(c->second)));
-						amx_Push(*i, static_cast<cell>(std::get<1>(c->second)));
-						amx_Exec(*i, NULL, amxIndex);
-					}
+					discoverMapIcon(player, m->second);
 				}
+				break;
 			}
-		}
-	}
-	if (!objectMoveCallbacks.empty())
-	{
-		std::vector<int> callbacks;
-		std::swap(objectMoveCallbacks, callbacks);
-		for (std::vector<int>::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
-		{
-			std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(*c);
-			if (o != core->getData()->objects.end())
+			case STREAMER_TYPE_3D_TEXT_LABEL:
 			{
-				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				std::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(d->second);
+				if (t != core->getData()->textLabels.end())
 				{
-					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnDynamicObjectMoved", &amxIndex))
-					{
-						amx_Push(*i, static_cast<cell>(*c));
-						amx_Exec(*i, NULL, amxIndex);
-					}
+					discoverTextLabel(player, t->second);
 				}
+				break;
 			}
 		}
 	}
-	if (!streamInCallbacks.empty())
+	streamObjects(player, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+	streamMapIcons(player);
+	streamTextLabels(player);
+	player.safeDistance = std::max(0.0f, std::min(safeDistance, player.safeDistance - static_cast<float>(boost::geometry::distance(player.position, player.safePosition))));
+}
+
+void Streamer::trimDirtyItems()
+{
+	std::size_t index = dirtyItemsBase + dirtyItems.size();
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		index = std::min(index, std::max(p->second.dirtyItemsIndex, dirtyItemsBase));
+	}
+	dirtyItems.erase(dirtyItems.begin(), dirtyItems.begin() + (index - dirtyItemsBase));
+	dirtyItemsBase = index;
+}
+
+void Streamer::trackScratchAllocations()
+{
+	std::size_t allocations = 0, capacity = playerUpdates.capacity() + discoveredMapIcons.capacity() + existingMapIcons.capacity() + discoveredObjects.capacity() + existingObjects.capacity() + removedObjects.capacity() + prefetchedObjects.capacity() + discoveredTextLabels.capacity() + existingTextLabels.capacity() + creationQueue.capacity() + sortedActors.capacity() + sortedPickups.capacity() + areaEnterCallbacks.capacity() + areaLeaveCallbacks.capacity() + areaCallbacks.capacity() + objectMoveCallbacks.capacity() + moveCallbacks.capacity() + streamInCallbacks.capacity() + streamOutCallbacks.capacity() + streamCallbacks.capacity();
+	for (std::vector<PlayerUpdate>::const_iterator u = playerUpdates.begin(); u != playerUpdates.end(); ++u)
+	{
+		capacity += u->cells.capacity() + u->discoveredObjects.capacity() + u->existingObjects.capacity() + u->removedObjects.capacity() + u->prefetchedObjects.capacity();
+	}
+	if (capacity > scratchCapacity)
 	{
-		std::vector<std::tuple<int, int, int> > callbacks;
-		std::swap(streamInCallbacks, callbacks);
-		for (std::vector<std::tuple<int, int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
+		++allocations;
+	}
+	scratchCapacity = capacity;
+	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		capacity = p->second.scratchCells.capacity() + p->second.updateCells.capacity();
+		if (capacity > p->second.scratchCapacity)
 		{
-			switch (std::get<0>(*c))
-			{
-				case STREAMER_TYPE_OBJECT:
-				{
-					if (core->getData()->objects.find(std::get<1>(*c)) == core->getData()->objects.end())
-					{
-						continue;
-					}
-					break;
-				}
-				case STREAMER_TYPE_PICKUP:
-				{
-					if (core->getData()->pickups.find(std::get<1>(*c)) == core->getData()->pickups.end())
-					{
-						continue;
-					}
-					break;
-				}
-				case STREAMER_TYPE_CP:
-				{
-					if (core->getData()->checkpoints.find(std::get<1>(*c)) == core->getData()->checkpoints.end())
+			++allocations;
+		}
+		p->second.scratchCapacity = capacity;
+	}
+	tickAllocations = allocations;
+}
+
+void Streamer::streamBudgetedItems(PlayerUpdate &playerUpdate, std::size_t budget)
+{
+	Player &player = *playerUpdate.player;
+	std::vector<std::pair<std::pair<int, float>, Item::Object*> > &objects = playerUpdate.objectsDiscovered ? playerUpdate.discoveredObjects : discoveredObjects;
+	creationQueue.clear();
+	for (std::vector<std::pair<std::pair<int, float>, Item::Object*> >::const_iterator o = objects.begin(); o != objects.end(); ++o)
+	{
+		creationQueue.push_back(std::make_pair(o->first, STREAMER_TYPE_OBJECT));
+	}
+	for (std::vector<std::pair<std::pair<int, float>, Item::MapIcon*> >::const_iterator m = discoveredMapIcons.begin(); m != discoveredMapIcons.end(); ++m)
+	{
+		creationQueue.push_back(std::make_pair(m->first, STREAMER_TYPE_MAP_ICON));
+	}
+	for (std::vector<std::pair<std::pair<int, float>, Item::TextLabel*> >::const_iterator t = discoveredTextLabels.begin(); t != discoveredTextLabels.end(); ++t)
+	{
+		creationQueue.push_back(std::make_pair(t->first, STREAMER_TYPE_3D_TEXT_LABEL));
+	}
+	if (creationQueue.size() > budget)
+	{
+		std::nth_element(creationQueue.begin(), creationQueue.begin() + budget, creationQueue.end(), Item::WorstFirstCompare<int>());
+		creationQueue.resize(budget);
+	}
+	std::size_t limits[STREAMER_MAX_TYPES] = { 0 };
+	for (std::vector<std::pair<std::pair<int, float>, int> >::const_iterator c = creationQueue.begin(); c != creationQueue.end(); ++c)
+	{
+		++limits[c->second];
+	}
+	if (playerUpdate.objectsDiscovered)
+	{
+		streamObjects(player, playerUpdate.discoveredObjects, playerUpdate.existingObjects, playerUpdate.removedObjects, playerUpdate.prefetchedObjects, limits[STREAMER_TYPE_OBJECT]);
+	}
+	else
+	{
+		streamObjects(player, discoveredObjects, existingObjects, removedObjects, prefetchedObjects, limits[STREAMER_TYPE_OBJECT]);
+	}
+	streamMapIcons(player, limits[STREAMER_TYPE_MAP_ICON]);
+	streamTextLabels(player, limits[STREAMER_TYPE_3D_TEXT_LABEL]);
+}
+
+std::size_t Streamer::getCreationCost(const Item::MapIcon *)
+{
+	return STREAMER_COST_MAP_ICON;
+}
+
+std::size_t Streamer::getCreationCost(const Item::Object *object)
+{
+	std::size_t cost = STREAMER_COST_OBJECT;
+	if (object->attach)
+	{
+		cost += STREAMER_COST_OBJECT_ATTACH;
+	}
+	else if (object->move)
+	{
+		cost += STREAMER_COST_OBJECT_MOVE;
+	}
+	if (object->noCameraCollision)
+	{
+		cost += STREAMER_COST_OBJECT_NO_CAMERA_COL;
+	}
+	for (std::unordered_map<int, Item::Object::Material>::const_iterator m = object->materials.begin(); m != object->materials.end(); ++m)
+	{
+		if (m->second.main)
+		{
+			cost += STREAMER_COST_OBJECT_MATERIAL + m->second.main->txdFileName.size() + m->second.main->textureName.size();
+		}
+		else if (m->second.text)
+		{
+			cost += STREAMER_COST_OBJECT_MATERIAL_TEXT + m->second.text->fontFace.size() + m->second.text->materialText.size();
+		}
+	}
+	return cost;
+}
+
+std::size_t Streamer::getCreationCost(const Item::TextLabel *textLabel)
+{
+	return STREAMER_COST_3D_TEXT_LABEL + textLabel->text.size();
+}
+
+void Streamer::restrictSafeDistance(Player &player, float comparableDistance, float comparableStreamDistance, bool dynamic)
+{
+	if (dynamic)
+	{
+		player.safeDistance = 0.0f;
+	}
+	else if (std::isfinite(comparableDistance) && comparableStreamDistance >= 0.0f)
+	{
+		player.safeDistance = std::min(player.safeDistance, std::fabs(std::sqrt(comparableStreamDistance) - std::sqrt(comparableDistance)));
+	}
+}
+
+void Streamer::executeCallbacks()
+{
+	if (!areaLeaveCallbacks.empty())
+	{
+		std::swap(areaLeaveCallbacks, areaCallbacks);
+		std::make_heap(areaCallbacks.begin(), areaCallbacks.end(), Item::HighestPriorityFirstCompare<std::tuple<int, int> >());
+		while (!areaCallbacks.empty())
+		{
+			std::pop_heap(areaCallbacks.begin(), areaCallbacks.end(), Item::HighestPriorityFirstCompare<std::tuple<int, int> >());
+			std::tuple<int, int> c = areaCallbacks.back().second;
+			areaCallbacks.pop_back();
+			std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(std::get<0>(c));
+			if (a != core->getData()->areas.end())
+			{
+				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				{
+					int amxIndex = 0;
+					if (!amx_FindPublic(*i, "OnPlayerLeaveDynamicArea", &amxIndex))
+					{
+						amx_Push(*i, static_cast<cell>(std::get<0>(c)));
+						amx_Push(*i, static_cast<cell>(std::get<1>(c)));
+						amx_Exec(*i, NULL, amxIndex);
+					}
+				}
+			}
+		}
+	}
+	if (!areaEnterCallbacks.empty())
+	{
+		std::swap(areaEnterCallbacks, areaCallbacks);
+		std::make_heap(areaCallbacks.begin(), areaCallbacks.end(), Item::HighestPriorityFirstCompare<std::tuple<int, int> >());
+		while (!areaCallbacks.empty())
+		{
+			std::pop_heap(areaCallbacks.begin(), areaCallbacks.end(), Item::HighestPriorityFirstCompare<std::tuple<int, int> >());
+			std::tuple<int, int> c = areaCallbacks.back().second;
+			areaCallbacks.pop_back();
+			std::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(std::get<0>(c));
+			if (a != core->getData()->areas.end())
+			{
+				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				{
+					int amxIndex = 0;
+					if (!amx_FindPublic(*i, "OnPlayerEnterDynamicArea", &amxIndex))
+					{
+						amx_Push(*i, static_cast<cell>(std::get<0>(c)));
+						amx_Push(*i, static_cast<cell>(std::get<1>(c)));
+						amx_Exec(*i, NULL, amxIndex);
+					}
+				}
+			}
+		}
+	}
+	if (!objectMoveCallbacks.empty())
+	{
+		std::swap(objectMoveCallbacks, moveCallbacks);
+		for (std::vector<int>::const_iterator c = moveCallbacks.begin(); c != moveCallbacks.end(); ++c)
+		{
+			std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(*c);
+			if (o != core->getData()->objects.end())
+			{
+				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
+				{
+					int amxIndex = 0;
+					if (!amx_FindPublic(*i, "OnDynamicObjectMoved", &amxIndex))
+					{
+						amx_Push(*i, static_cast<cell>(*c));
+						amx_Exec(*i, NULL, amxIndex);
+					}
+				}
+			}
+		}
+		moveCallbacks.clear();
+	}
+	if (!streamInCallbacks.empty())
+	{
+		std::swap(streamInCallbacks, streamCallbacks);
+		for (std::vector<std::tuple<int, int, int> >::const_iterator c = streamCallbacks.begin(); c != streamCallbacks.end(); ++c)
+		{
+			switch (std::get<0>(*c))
+			{
+				case STREAMER_TYPE_OBJECT:
+				{
+					if (core->getData()->objects.find(std::get<1>(*c)) == core->getData()->objects.end())
+					{
+						continue;
+					}
+					break;
+				}
+				case STREAMER_TYPE_PICKUP:
+				{
+					if (core->getData()->pickups.find(std::get<1>(*c)) == core->getData()->pickups.end())
+					{
+						continue;
+					}
+					break;
+				}
+				case STREAMER_TYPE_CP:
+				{
+					if (core->getData()->checkpoints.find(std::get<1>(*c)) == core->getData()->checkpoints.end())
 					{
 						continue;
 					}
@@ -428,12 +1019,12 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		streamCallbacks.clear();
 	}
 	if (!streamOutCallbacks.empty())
 	{
-		std::vector<std::tuple<int, int, int> > callbacks;
-		std::swap(streamOutCallbacks, callbacks);
-		for (std::vector<std::tuple<int, int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
+		std::swap(streamOutCallbacks, streamCallbacks);
+		for (std::vector<std::tuple<int, int, int> >::const_iterator c = streamCallbacks.begin(); c != streamCallbacks.end(); ++c)
 		{
 			switch (std::get<0>(*c))
 			{
@@ -498,42 +1089,55 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		streamCallbacks.clear();
 	}
 }
 
-void Streamer::discoverActors(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::discoverActors(Player &player, const std::vector<Cell*> &cells)
 {
 	if (!sampgdk::IsPlayerNPC(player.playerId))
 	{
-		for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+		for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 		{
 			for (std::unordered_map<int, Item::SharedActor>::const_iterator a = (*c)->actors.begin(); a != (*c)->actors.end(); ++a)
 			{
-				std::unordered_set<int> worlds = a->second->worlds;
-				if (worlds.empty())
+				if (a->second->worlds.empty())
 				{
-					worlds.insert(-1);
+					discoverActor(player, a->second, -1);
+					continue;
 				}
-
-				for (std::unordered_set<int>::const_iterator w = worlds.begin(); w != worlds.end(); ++w)
+				for (std::unordered_set<int>::const_iterator w = a->second->worlds.begin(); w != a->second->worlds.end(); ++w)
 				{
-					if (player.worldId != *w && *w != -1)
+					if (player.worldId == *w || *w == -1)
 					{
-						continue;
+						discoverActor(player, a->second, *w);
 					}
+				}
+			}
+		}
+	}
+}
 
-					std::unordered_map<std::pair<int, int>, Item::SharedActor, pair_hash>::iterator d = core->getData()->discoveredActors.find(std::make_pair(a->first, *w));
-					if (d == core->getData()->discoveredActors.end())
-					{
-						const int playerWorldId = *w == -1 ? -1 : player.worldId;
-						if (doesPlayerSatisfyConditions(a->second->players, player.playerId, a->second->interiors, player.interiorId, a->second->worlds, playerWorldId, a->second->areas, player.internalAreas, a->second->inverseAreaChecking))
-						{
-							if (a->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(a->second->position + a->second->positionOffset)) < (a->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_ACTOR]))
-							{
-								core->getData()->discoveredActors.insert(std::make_pair(std::make_pair(a->first, *w), a->second));
-							}
-						}
-					}
+void Streamer::discoverActor(Player &player, const Item::SharedActor &actor, int worldId)
+{
+	std::unordered_map<std::pair<int, int>, Item::SharedActor, pair_hash>::iterator d = core->getData()->discoveredActors.find(std::make_pair(actor->actorId, worldId));
+	if (d == core->getData()->discoveredActors.end() || !actorStreamOutTimes.empty())
+	{
+		const int playerWorldId = worldId == -1 ? -1 : player.worldId;
+		if (doesPlayerSatisfyConditions(actor->players, player.playerId, actor->interiors, player.interiorId, actor->worlds, playerWorldId, actor->areas, player.internalAreas, actor->inverseAreaChecking))
+		{
+			float distance = std::numeric_limits<float>::infinity() * -1.0f;
+			if (actor->comparableStreamDistance > STREAMER_STATIC_DISTANCE_CUTOFF)
+			{
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(actor->position + actor->positionOffset)));
+			}
+			float comparableStreamDistance = actor->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_ACTOR];
+			std::unordered_map<std::pair<int, int>, int, pair_hash>::iterator i = core->getData()->internalActors.find(std::make_pair(actor->actorId, worldId));
+			if (i == core->getData()->internalActors.end() ? distance < comparableStreamDistance : isWithinStreamOutRange(actorStreamOutTimes, i->first, distance, getComparableStreamOutDistance(comparableStreamDistance, actor->streamOutMargin), actor->streamOutGrace))
+			{
+				if (d == core->getData()->discoveredActors.end())
+				{
+					core->getData()->discoveredActors.insert(std::make_pair(std::make_pair(actor->actorId, worldId), actor));
 				}
 			}
 		}
@@ -549,6 +1153,10 @@ void Streamer::streamActors()
 		if (d == core->getData()->discoveredActors.end())
 		{
 			sampgdk::DestroyActor(i->second);
+			if (!actorStreamOutTimes.empty())
+			{
+				actorStreamOutTimes.erase(i->first);
+			}
 			i = core->getData()->internalActors.erase(i);
 		}
 		else
@@ -557,38 +1165,42 @@ void Streamer::streamActors()
 			++i;
 		}
 	}
-	std::multimap<int, std::pair<int, Item::SharedActor> > sortedActors;
+	sortedActors.clear();
 	for (std::unordered_map<std::pair<int, int>, Item::SharedActor, pair_hash>::iterator d = core->getData()->discoveredActors.begin(); d != core->getData()->discoveredActors.end(); ++d)
 	{
-		sortedActors.insert(std::make_pair(d->second->priority, std::make_pair(d->first.second, d->second)));
+		sortedActors.push_back(std::make_pair(d->second->priority, std::make_pair(d->first.second, d->second.get())));
 	}
 	core->getData()->discoveredActors.clear();
-	for (std::multimap<int, std::pair<int, Item::SharedActor> >::iterator s = sortedActors.begin(); s != sortedActors.end(); ++s)
+	std::make_heap(sortedActors.begin(), sortedActors.end(), Item::LowestPriorityFirstCompare<std::pair<int, Item::Actor*> >());
+	while (!sortedActors.empty())
 	{
 		if (core->getData()->internalActors.size() == core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_ACTOR))
 		{
 			break;
 		}
-		int internalId = sampgdk::CreateActor(s->second.second->modelId, s->second.second->position[0], s->second.second->position[1], s->second.second->position[2], s->second.second->rotation);
+		std::pop_heap(sortedActors.begin(), sortedActors.end(), Item::LowestPriorityFirstCompare<std::pair<int, Item::Actor*> >());
+		std::pair<int, Item::Actor*> s = sortedActors.back().second;
+		sortedActors.pop_back();
+		int internalId = sampgdk::CreateActor(s.second->modelId, s.second->position[0], s.second->position[1], s.second->position[2], s.second->rotation);
 		if (internalId == INVALID_ACTOR_ID)
 		{
 			break;
 		}
-		sampgdk::SetActorInvulnerable(internalId, s->second.second->invulnerable);
-		sampgdk::SetActorHealth(internalId, s->second.second->health);
-		sampgdk::SetActorVirtualWorld(internalId, s->second.first);
-		if (s->second.second->anim)
+		sampgdk::SetActorInvulnerable(internalId, s.second->invulnerable);
+		sampgdk::SetActorHealth(internalId, s.second->health);
+		sampgdk::SetActorVirtualWorld(internalId, s.first);
+		if (s.second->anim)
 		{
-			sampgdk::ApplyActorAnimation(internalId, s->second.second->anim->lib.c_str(), s->second.second->anim->name.c_str(), s->second.second->anim->delta, s->second.second->anim->loop, s->second.second->anim->lockx, s->second.second->anim->locky, s->second.second->anim->freeze, s->second.second->anim->time);
+			sampgdk::ApplyActorAnimation(internalId, s.second->anim->lib.c_str(), s.second->anim->name.c_str(), s.second->anim->delta, s.second->anim->loop, s.second->anim->lockx, s.second->anim->locky, s.second->anim->freeze, s.second->anim->time);
 		}
-		core->getData()->internalActors.insert(std::make_pair(std::make_pair(s->second.second->actorId, s->second.first), internalId));
+		core->getData()->internalActors.insert(std::make_pair(std::make_pair(s.second->actorId, s.first), internalId));
 	}
 }
 
-void Streamer::processAreas(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processAreas(Player &player, const std::vector<Cell*> &cells)
 {
 	int state = sampgdk::GetPlayerState(player.playerId);
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedArea>::const_iterator a = (*c)->areas.begin(); a != (*c)->areas.end(); ++a)
 		{
@@ -610,7 +1222,7 @@ bool Streamer::processPlayerArea(Player &player, const Item::SharedArea &a, cons
 		if (foundArea == player.internalAreas.end())
 		{
 			player.internalAreas.insert(a->areaId);
-			areaEnterCallbacks.insert(std::make_pair(a->priority, std::make_tuple(a->areaId, player.playerId)));
+			areaEnterCallbacks.push_back(std::make_pair(a->priority, std::make_tuple(a->areaId, player.playerId)));
 		}
 		if (a->cell)
 		{
@@ -622,16 +1234,16 @@ bool Streamer::processPlayerArea(Player &player, const Item::SharedArea &a, cons
 		if (foundArea != player.internalAreas.end())
 		{
 			player.internalAreas.erase(foundArea);
-			areaLeaveCallbacks.insert(std::make_pair(a->priority, std::make_tuple(a->areaId, player.playerId)));
+			areaLeaveCallbacks.push_back(std::make_pair(a->priority, std::make_tuple(a->areaId, player.playerId)));
 		}
 	}
 	return inArea;
 }
 
-void Streamer::processCheckpoints(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processCheckpoints(Player &player, const std::vector<Cell*> &cells)
 {
-	std::multimap<std::pair<int, float>, Item::SharedCheckpoint, Item::PairCompare> discoveredCheckpoints;
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	std::pair<std::pair<int, float>, Item::SharedCheckpoint> discoveredCheckpoint;
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedCheckpoint>::const_iterator d = (*c)->checkpoints.begin(); d != (*c)->checkpoints.end(); ++d)
 		{
@@ -649,7 +1261,11 @@ void Streamer::processCheckpoints(Player &player, const std::vector<SharedCell>
 			}
 			if (distance < (d->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_CP]))
 			{
-				discoveredCheckpoints.insert(std::make_pair(std::make_pair(d->second->priority, distance), d->second));
+				std::pair<int, float> key = std::make_pair(d->second->priority, distance);
+				if (!discoveredCheckpoint.second || Item::PairCompare()(key, discoveredCheckpoint.first))
+				{
+					discoveredCheckpoint = std::make_pair(key, d->second);
+				}
 			}
 			else
 			{
@@ -667,9 +1283,9 @@ void Streamer::processCheckpoints(Player &player, const std::vector<SharedCell>
 			}
 		}
 	}
-	if (!discoveredCheckpoints.empty())
+	if (discoveredCheckpoint.second)
 	{
-		std::multimap<std::pair<int, float>, Item::SharedCheckpoint, Item::PairCompare>::iterator d = discoveredCheckpoints.begin();
+		const std::pair<std::pair<int, float>, Item::SharedCheckpoint> *d = &discoveredCheckpoint;
 		if (d->second->checkpointId != player.visibleCheckpoint)
 		{
 			if (player.visibleCheckpoint)
@@ -690,86 +1306,128 @@ void Streamer::processCheckpoints(Player &player, const std::vector<SharedCell>
 	}
 }
 
-void Streamer::processMapIcons(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processMapIcons(Player &player, const std::vector<Cell*> &cells)
 {
-	std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::PairCompare> discoveredMapIcons, existingMapIcons;
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	discoveredMapIcons.clear();
+	existingMapIcons.clear();
+	discoverMapIcons(player, cells);
+	streamMapIcons(player);
+}
+
+void Streamer::discoverMapIcons(Player &player, const std::vector<Cell*> &cells)
+{
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedMapIcon>::const_iterator m = (*c)->mapIcons.begin(); m != (*c)->mapIcons.end(); ++m)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(m->second->players, player.playerId, m->second->interiors, player.interiorId, m->second->worlds, player.worldId, m->second->areas, player.internalAreas, m->second->inverseAreaChecking))
-			{
-				if (m->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
-				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
-				}
-				else
-				{
-					distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(m->second->position + m->second->positionOffset)));
-				}
-			}
-			std::unordered_map<int, int>::iterator i = player.internalMapIcons.find(m->first);
-			if (distance < (m->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_MAP_ICON]))
+			discoverMapIcon(player, m->second);
+		}
+	}
+}
+
+void Streamer::discoverMapIcon(Player &player, const Item::SharedMapIcon &mapIcon)
+{
+	float distance = std::numeric_limits<float>::infinity();
+	if (doesPlayerSatisfyConditions(mapIcon->players, player.playerId, mapIcon->interiors, player.interiorId, mapIcon->worlds, player.worldId, mapIcon->areas, player.internalAreas, mapIcon->inverseAreaChecking))
+	{
+		if (mapIcon->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(mapIcon->position + mapIcon->positionOffset)));
+		}
+	}
+	std::unordered_map<int, int>::iterator i = player.internalMapIcons.find(mapIcon->mapIconId);
+	float comparableStreamDistance = mapIcon->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_MAP_ICON];
+	if (i != player.internalMapIcons.end())
+	{
+		comparableStreamDistance = getComparableStreamOutDistance(comparableStreamDistance, mapIcon->streamOutMargin);
+	}
+	if (safeDistanceSkip)
+	{
+		restrictSafeDistance(player, distance, comparableStreamDistance, !mapIcon->areas.empty());
+	}
+	if (i == player.internalMapIcons.end() ? distance < comparableStreamDistance : isWithinStreamOutRange(player.streamOutTimes[STREAMER_TYPE_MAP_ICON], mapIcon->mapIconId, distance, comparableStreamDistance, mapIcon->streamOutGrace))
+	{
+		if (i == player.internalMapIcons.end())
+		{
+			discoveredMapIcons.push_back(std::make_pair(std::make_pair(mapIcon->priority, distance), mapIcon.get()));
+		}
+		else
+		{
+			if (mapIcon->cell)
 			{
-				if (i == player.internalMapIcons.end())
-				{
-					discoveredMapIcons.insert(std::make_pair(std::make_pair(m->second->priority, distance), m->second));
-				}
-				else
-				{
-					if (m->second->cell)
-					{
-						player.visibleCell->mapIcons.insert(*m);
-					}
-					existingMapIcons.insert(std::make_pair(std::make_pair(m->second->priority, distance), m->second));
-				}
+				player.visibleCell->mapIcons.insert(std::make_pair(mapIcon->mapIconId, mapIcon));
 			}
-			else
+			existingMapIcons.push_back(std::make_pair(std::make_pair(mapIcon->priority, distance), mapIcon.get()));
+		}
+	}
+	else
+	{
+		if (i != player.internalMapIcons.end())
+		{
+			sampgdk::RemovePlayerMapIcon(player.playerId, i->second);
+			if (mapIcon->streamCallbacks)
 			{
-				if (i != player.internalMapIcons.end())
-				{
-					sampgdk::RemovePlayerMapIcon(player.playerId, i->second);
-					if (m->second->streamCallbacks)
-					{
-						streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, m->first, player.playerId));
-					}
-					player.mapIconIdentifier.remove(i->second, player.internalMapIcons.size());
-					player.internalMapIcons.erase(i);
-				}
+				streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, mapIcon->mapIconId, player.playerId));
 			}
+			player.mapIconIdentifier.remove(i->second, player.internalMapIcons.size());
+			player.internalMapIcons.erase(i);
 		}
 	}
-	for (std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::PairCompare>::iterator d = discoveredMapIcons.begin(); d != discoveredMapIcons.end(); ++d)
+}
+
+void Streamer::streamMapIcons(Player &player, std::size_t limit)
+{
+	std::make_heap(discoveredMapIcons.begin(), discoveredMapIcons.end(), Item::BestFirstCompare<Item::MapIcon*>());
+	std::make_heap(existingMapIcons.begin(), existingMapIcons.end(), Item::WorstFirstCompare<Item::MapIcon*>());
+	while (!discoveredMapIcons.empty())
 	{
-		std::unordered_map<int, int>::iterator i = player.internalMapIcons.find(d->second->mapIconId);
+		std::pop_heap(discoveredMapIcons.begin(), discoveredMapIcons.end(), Item::BestFirstCompare<Item::MapIcon*>());
+		std::pair<std::pair<int, float>, Item::MapIcon*> d = std::move(discoveredMapIcons.back());
+		discoveredMapIcons.pop_back();
+		std::unordered_map<int, int>::iterator i = player.internalMapIcons.find(d.second->mapIconId);
 		if (i != player.internalMapIcons.end())
 		{
 			continue;
 		}
+		if (!limit || !reserveCreationBytes(getCreationCost(d.second)))
+		{
+			player.safeDistance = 0.0f;
+			player.creationBacklog = true;
+			break;
+		}
 		if (player.internalMapIcons.size() == player.maxVisibleMapIcons)
 		{
-			std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::PairCompare>::reverse_iterator e = existingMapIcons.rbegin();
-			if (e != existingMapIcons.rend())
+			player.safeDistance = 0.0f;
+			if (!existingMapIcons.empty())
 			{
-				if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+				const std::pair<std::pair<int, float>, Item::MapIcon*> &e = existingMapIcons.front();
+				if (e.first.first < d.first.first || (e.first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d.first.second < e.first.second))
 				{
-					std::unordered_map<int, int>::iterator j = player.internalMapIcons.find(e->second->mapIconId);
+					std::unordered_map<int, int>::iterator j = player.internalMapIcons.find(e.second->mapIconId);
 					if (j != player.internalMapIcons.end())
 					{
 						sampgdk::RemovePlayerMapIcon(player.playerId, j->second);
-						if (e->second->streamCallbacks)
+						if (e.second->streamCallbacks)
 						{
-							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, e->second->mapIconId, player.playerId));
+							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, e.second->mapIconId, player.playerId));
 						}
 						player.mapIconIdentifier.remove(j->second, player.internalMapIcons.size());
 						player.internalMapIcons.erase(j);
 					}
-					if (e->second->cell)
+					if (e.second->cell)
+					{
+						player.visibleCell->mapIcons.erase(e.second->mapIconId);
+					}
+					if (!player.streamOutTimes[STREAMER_TYPE_MAP_ICON].empty())
 					{
-						player.visibleCell->mapIcons.erase(e->second->mapIconId);
+						player.streamOutTimes[STREAMER_TYPE_MAP_ICON].erase(e.second->mapIconId);
 					}
-					existingMapIcons.erase(--e.base());
+					std::pop_heap(existingMapIcons.begin(), existingMapIcons.end(), Item::WorstFirstCompare<Item::MapIcon*>());
+					existingMapIcons.pop_back();
 				}
 			}
 			if (player.internalMapIcons.size() == player.maxVisibleMapIcons)
@@ -778,15 +1436,20 @@ void Streamer::processMapIcons(Player &player, const std::vector<SharedCell> &ce
 			}
 		}
 		int internalId = player.mapIconIdentifier.get();
-		sampgdk::SetPlayerMapIcon(player.playerId, internalId, d->second->position[0], d->second->position[1], d->second->position[2], d->second->type, d->second->color, d->second->style);
-		if (d->second->streamCallbacks)
+		sampgdk::SetPlayerMapIcon(player.playerId, internalId, d.second->position[0], d.second->position[1], d.second->position[2], d.second->type, d.second->color, d.second->style);
+		if (d.second->streamCallbacks)
 		{
-			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, d->second->mapIconId, player.playerId));
+			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_MAP_ICON, d.second->mapIconId, player.playerId));
 		}
-		player.internalMapIcons.insert(std::make_pair(d->second->mapIconId, internalId));
-		if (d->second->cell)
+		player.internalMapIcons.insert(std::make_pair(d.second->mapIconId, internalId));
+		--limit;
+		if (d.second->cell)
 		{
-			player.visibleCell->mapIcons.insert(std::make_pair(d->second->mapIconId, d->second));
+			std::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(d.second->mapIconId);
+			if (m != core->getData()->mapIcons.end())
+			{
+				player.visibleCell->mapIcons.insert(*m);
+			}
 		}
 	}
 }
@@ -795,7 +1458,7 @@ void Streamer::createObjectForPlayers(const Item::SharedObject &object)
 {
 	for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 	{
-		if (std::abs(p->second.position[2] - object->position[2]) < 400.0 && doesPlayerSatisfyConditions(object->players, p->second.playerId, object->interiors, p->second.interiorId, object->attach ? object->attach->worlds : object->worlds, p->second.worldId, object->areas, p->second.internalAreas, object->inverseAreaChecking))
+		if (std::abs(p->second.position[2] - object->position[2]) < std::get<1>(verticalRanges) && doesPlayerSatisfyConditions(object->players, p->second.playerId, object->interiors, p->second.interiorId, object->attach ? object->attach->worlds : object->worlds, p->second.worldId, object->areas, p->second.internalAreas, object->inverseAreaChecking))
 		{
 			float distance = static_cast<float>(boost::geometry::comparable_distance(p->second.position, Eigen::Vector3f(object->position + object->positionOffset)));
 
@@ -822,85 +1485,212 @@ void Streamer::createObjectForPlayers(const Item::SharedObject &object)
 	}
 }
 
-void Streamer::processObjects(Player &player, const std::vector<SharedCell> &cells)
+float Streamer::getObjectDistance(Player &player, const Item::SharedObject &object)
 {
-	std::multimap<std::pair<int, float>, Item::SharedObject, Item::PairCompare> discoveredObjects, existingObjects;
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	float distance = std::numeric_limits<float>::infinity();
+	if (std::abs(player.position[2] - object->position[2]) < std::get<0>(verticalRanges) && doesPlayerSatisfyConditions(object->players, player.playerId, object->interiors, player.interiorId, object->attach ? object->attach->worlds : object->worlds, player.worldId, object->areas, player.internalAreas, object->inverseAreaChecking))
 	{
-		for (std::unordered_map<int, Item::SharedObject>::const_iterator o = (*c)->objects.begin(); o != (*c)->objects.end(); ++o)
+		if (object->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (std::abs(player.position[2] - o->second->position[2]) < 500.0 && doesPlayerSatisfyConditions(o->second->players, player.playerId, o->second->interiors, player.interiorId, o->second->attach ? o->second->attach->worlds : o->second->worlds, player.worldId, o->second->areas, player.internalAreas, o->second->inverseAreaChecking))
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			if (object->attach)
 			{
-				if (o->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
-				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
-				}
-				else
-				{
-					if (o->second->attach)
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, o->second->attach->position)) + std::numeric_limits<float>::epsilon();
-					}
-					else
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(o->second->position + o->second->positionOffset)));
-					}
-				}
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, object->attach->position)) + std::numeric_limits<float>::epsilon();
+			}
+			else
+			{
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(object->position + object->positionOffset)));
 			}
-			
-			std::unordered_map<int, int>::iterator i = player.internalObjects.find(o->first);
+		}
+	}
+	return distance;
+}
 
-			if (distance < (o->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT]))
+float Streamer::getObjectStreamDistance(Player &player, const Item::SharedObject &object, bool visible)
+{
+	float comparableStreamDistance = object->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT];
+	if (visible)
+	{
+		comparableStreamDistance = getComparableStreamOutDistance(comparableStreamDistance, object->streamOutMargin);
+	}
+	return comparableStreamDistance;
+}
+
+void Streamer::discoverObject(Player &player, const Item::SharedObject &object, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects)
+{
+	float distance = getObjectDistance(player, object);
+	std::unordered_map<int, int>::iterator i = player.internalObjects.find(object->objectId);
+	float comparableStreamDistance = getObjectStreamDistance(player, object, i != player.internalObjects.end());
+
+	if (safeDistanceSkip)
+	{
+		player.safeDistance = std::min(player.safeDistance, std::fabs(std::get<0>(verticalRanges) - std::abs(player.position[2] - object->position[2])));
+		restrictSafeDistance(player, distance, comparableStreamDistance, object->attach || object->move || !object->areas.empty());
+	}
+
+	if (i == player.internalObjects.end() ? distance < comparableStreamDistance : isWithinStreamOutRange(player.streamOutTimes[STREAMER_TYPE_OBJECT], object->objectId, distance, comparableStreamDistance, object->streamOutGrace))
+	{
+		if (i == player.internalObjects.end())
+		{
+			discoveredObjects.push_back(std::make_pair(std::make_pair(object->priority, distance), object.get()));
+		}
+		else
+		{
+			if (object->cell)
 			{
-				if (i == player.internalObjects.end())
-				{
-					discoveredObjects.insert(std::make_pair(std::make_pair(o->second->priority, distance), o->second));
-				}
-				else
-				{
-					if (o->second->cell)
-					{
-						player.visibleCell->objects.insert(*o);
-					}
-					existingObjects.insert(std::make_pair(std::make_pair(o->second->priority, distance), o->second));
-				}
+				player.visibleCell->objects.insert(std::make_pair(object->objectId, object));
+			}
+			existingObjects.push_back(std::make_pair(std::make_pair(object->priority, distance), object.get()));
+		}
+	}
+	else
+	{
+		float arrival = -1.0f;
+		if (!player.prefetchOffset.isZero() && !object->attach && std::isfinite(distance))
+		{
+			arrival = getPrefetchArrival(player.position, player.prefetchOffset, Eigen::Vector3f(object->position + object->positionOffset), comparableStreamDistance);
+		}
+		if (arrival >= 0.0f)
+		{
+			if (i == player.internalObjects.end())
+			{
+				prefetchedObjects.push_back(std::make_pair(std::make_pair(object->priority, arrival), object.get()));
 			}
 			else
 			{
-				if (i != player.internalObjects.end())
+				if (object->cell)
 				{
-					if (player.selectObject == o->first)
-					{
-						sampgdk::CancelEdit(player.playerId);
-
-						player.selectObject = 0;
-					}
-					player.playerObjectsIndex[i->second] = 0;
-
-					sampgdk::DestroyPlayerObject(player.playerId, i->second);
-					if (o->second->streamCallbacks)
-					{
-						streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, o->first, player.playerId));
-					}
-					player.internalObjects.erase(i);
+					player.visibleCell->objects.insert(std::make_pair(object->objectId, object));
 				}
+				existingObjects.push_back(std::make_pair(std::make_pair(object->priority, distance), object.get()));
 			}
 		}
+		else if (i != player.internalObjects.end())
+		{
+			removedObjects.push_back(object.get());
+		}
 	}
-	for (std::multimap<std::pair<int, float>, Item::SharedObject, Item::PairCompare>::iterator d = discoveredObjects.begin(); d != discoveredObjects.end(); ++d)
+}
+
+void Streamer::discoverFrozenObject(Player &player, const Item::FrozenObject &object, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects)
+{
+	if (object.restricted || player.internalObjects.find(object.objectId) != player.internalObjects.end())
+	{
+		discoverObject(player, object.object, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+		return;
+	}
+	float distance = std::numeric_limits<float>::infinity();
+	if (std::abs(player.position[2] - object.height) < std::get<0>(verticalRanges) && (object.interiorId == -1 || object.interiorId == player.interiorId) && (object.worldId == -1 || object.worldId == player.worldId))
 	{
-		std::unordered_map<int, int>::iterator i = player.internalObjects.find(d->second->objectId);
+		if (object.comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			distance = static_cast<float>(boost::geometry::comparable_distance(player.position, object.position));
+		}
+	}
+	float comparableStreamDistance = object.comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT];
+
+	if (safeDistanceSkip)
+	{
+		player.safeDistance = std::min(player.safeDistance, std::fabs(std::get<0>(verticalRanges) - std::abs(player.position[2] - object.height)));
+		restrictSafeDistance(player, distance, comparableStreamDistance, false);
+	}
+
+	if (distance < comparableStreamDistance)
+	{
+		discoveredObjects.push_back(std::make_pair(std::make_pair(object.priority, distance), object.object.get()));
+	}
+	else if (!player.prefetchOffset.isZero() && std::isfinite(distance))
+	{
+		float arrival = getPrefetchArrival(player.position, player.prefetchOffset, object.position, comparableStreamDistance);
+		if (arrival >= 0.0f)
+		{
+			prefetchedObjects.push_back(std::make_pair(std::make_pair(object.priority, arrival), object.object.get()));
+		}
+	}
+}
+
+float Streamer::getPrefetchArrival(const Eigen::Vector3f &position, const Eigen::Vector3f &offset, const Eigen::Vector3f &target, float comparableStreamDistance)
+{
+	Eigen::Vector3f relative = position - target;
+	float a = offset.squaredNorm(), b = 2.0f * offset.dot(relative), c = relative.squaredNorm() - comparableStreamDistance;
+	float discriminant = (b * b) - (4.0f * a * c);
+	if (a > 0.0f && discriminant >= 0.0f)
+	{
+		float arrival = (-b - std::sqrt(discriminant)) / (2.0f * a);
+		if (arrival >= 0.0f && arrival <= 1.0f)
+		{
+			return arrival;
+		}
+	}
+	return -1.0f;
+}
+
+void Streamer::discoverObjects(Player &player, const std::vector<Cell*> &cells, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects)
+{
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	{
+		for (std::unordered_map<int, Item::SharedObject>::const_iterator o = (*c)->objects.begin(); o != (*c)->objects.end(); ++o)
+		{
+			discoverObject(player, o->second, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+		}
+		for (std::vector<Item::FrozenObject>::const_iterator o = (*c)->frozenObjects.begin(); o != (*c)->frozenObjects.end(); ++o)
+		{
+			discoverFrozenObject(player, *o, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+		}
+	}
+}
+
+void Streamer::processObjects(Player &player, const std::vector<Cell*> &cells)
+{
+	discoveredObjects.clear();
+	existingObjects.clear();
+	removedObjects.clear();
+	prefetchedObjects.clear();
+	discoverObjects(player, cells, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+	streamObjects(player, discoveredObjects, existingObjects, removedObjects, prefetchedObjects);
+}
+
+void Streamer::streamObjects(Player &player, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, const std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects, std::size_t limit)
+{
+	for (std::vector<Item::Object*>::const_iterator r = removedObjects.begin(); r != removedObjects.end(); ++r)
+	{
+		std::unordered_map<int, int>::iterator i = player.internalObjects.find((*r)->objectId);
+		if (i != player.internalObjects.end())
+		{
+			destroyPlayerObject(player, *r, i);
+		}
+	}
+	std::make_heap(discoveredObjects.begin(), discoveredObjects.end(), Item::BestFirstCompare<Item::Object*>());
+	std::make_heap(existingObjects.begin(), existingObjects.end(), Item::WorstFirstCompare<Item::Object*>());
+	while (!discoveredObjects.empty())
+	{
+		std::pop_heap(discoveredObjects.begin(), discoveredObjects.end(), Item::BestFirstCompare<Item::Object*>());
+		std::pair<std::pair<int, float>, Item::Object*> d = std::move(discoveredObjects.back());
+		discoveredObjects.pop_back();
+		std::unordered_map<int, int>::iterator i = player.internalObjects.find(d.second->objectId);
 		if (i != player.internalObjects.end())
 		{
 			continue;
 		}
+		if (!limit || !reserveCreationBytes(getCreationCost(d.second)))
+		{
+			player.safeDistance = 0.0f;
+			player.creationBacklog = true;
+			break;
+		}
 		int internalBaseId = INVALID_STREAMER_ID;
-		if (d->second->attach)
+		if (d.second->attach)
 		{
-			if (d->second->attach->object != INVALID_STREAMER_ID)
+			if (d.second->attach->object != INVALID_STREAMER_ID)
 			{
-				std::unordered_map<int, int>::iterator j = player.internalObjects.find(d->second->attach->object);
+				std::unordered_map<int, int>::iterator j = player.internalObjects.find(d.second->attach->object);
 				if (j == player.internalObjects.end())
 				{
 					continue;
@@ -910,36 +1700,23 @@ void Streamer::processObjects(Player &player, const std::vector<SharedCell> &cel
 		}
 		if (player.internalObjects.size() == player.currentVisibleObjects)
 		{
-			std::multimap<std::pair<int, float>, Item::SharedObject, Item::PairCompare>::reverse_iterator e = existingObjects.rbegin();
-			if (e != existingObjects.rend())
+			player.safeDistance = 0.0f;
+			if (!existingObjects.empty())
 			{
-				if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+				const std::pair<std::pair<int, float>, Item::Object*> &e = existingObjects.front();
+				if (e.first.first < d.first.first || (e.first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d.first.second < e.first.second))
 				{
-					std::unordered_map<int, int>::iterator j = player.internalObjects.find(e->second->objectId);
+					std::unordered_map<int, int>::iterator j = player.internalObjects.find(e.second->objectId);
 					if (j != player.internalObjects.end())
 					{
-						if (player.selectObject == e->second->objectId)
-						{
-							sampgdk::CancelEdit(player.playerId);
-
-							player.selectObject = 0;
-						}
-
-						player.playerObjectsIndex[j->second] = 0;
-
-						sampgdk::DestroyPlayerObject(player.playerId, j->second);
-
-						if (e->second->streamCallbacks)
-						{
-							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, e->second->objectId, player.playerId));
-						}
-						player.internalObjects.erase(j);
+						destroyPlayerObject(player, e.second, j);
 					}
-					if (e->second->cell)
+					if (e.second->cell)
 					{
-						player.visibleCell->objects.erase(e->second->objectId);
+						player.visibleCell->objects.erase(e.second->objectId);
 					}
-					existingObjects.erase(--e.base());
+					std::pop_heap(existingObjects.begin(), existingObjects.end(), Item::WorstFirstCompare<Item::Object*>());
+					existingObjects.pop_back();
 				}
 			}
 		}
@@ -948,100 +1725,166 @@ void Streamer::processObjects(Player &player, const std::vector<SharedCell> &cel
 			player.currentVisibleObjects = player.internalObjects.size();
 			break;
 		}
-		int internalId = sampgdk::CreatePlayerObject(player.playerId, d->second->modelId, d->second->position[0], d->second->position[1], d->second->position[2], d->second->rotation[0], d->second->rotation[1], d->second->rotation[2], d->second->drawDistance);
-		if (internalId == INVALID_OBJECT_ID)
+		if (!createPlayerObject(player, d.second, internalBaseId))
 		{
+			player.safeDistance = 0.0f;
 			player.currentVisibleObjects = player.internalObjects.size();
 			break;
 		}
-		player.playerObjectsIndex[internalId] = d->second->objectId;
-		player.playerObjectShootable[internalId] = d->second->shootable;
-
-		if (d->second->streamCallbacks)
-		{
-			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, d->second->objectId, player.playerId));
-		}
-		if (d->second->attach)
+		--limit;
+	}
+	if (discoveredObjects.empty() && !prefetchedObjects.empty())
+	{
+		std::size_t updates = std::max<std::size_t>(prefetchUpdates, 1), count = (prefetchedObjects.size() + updates - 1) / updates;
+		std::make_heap(prefetchedObjects.begin(), prefetchedObjects.end(), Item::BestFirstCompare<Item::Object*>());
+		while (count && limit && !prefetchedObjects.empty() && player.internalObjects.size() < player.maxVisibleObjects)
 		{
-			if (internalBaseId != INVALID_STREAMER_ID)
+			std::pop_heap(prefetchedObjects.begin(), prefetchedObjects.end(), Item::BestFirstCompare<Item::Object*>());
+			Item::Object *object = prefetchedObjects.back().second;
+			prefetchedObjects.pop_back();
+			if (player.internalObjects.find(object->objectId) != player.internalObjects.end())
 			{
-				static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
-				if (native != NULL)
-				{
-					sampgdk::InvokeNative(native, "dddffffffb", player.playerId, internalId, internalBaseId, d->second->attach->positionOffset[0], d->second->attach->positionOffset[1], d->second->attach->positionOffset[2], d->second->attach->rotation[0], d->second->attach->rotation[1], d->second->attach->rotation[2], d->second->attach->syncRotation);
-				}
+				continue;
 			}
-			else if (d->second->attach->player != INVALID_PLAYER_ID)
+			if (!reserveCreationBytes(getCreationCost(object)))
 			{
-				static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
-				if (native != NULL)
-				{
-					sampgdk::InvokeNative(native, "dddffffffd", player.playerId, internalId, d->second->attach->player, d->second->attach->positionOffset[0], d->second->attach->positionOffset[1], d->second->attach->positionOffset[2], d->second->attach->rotation[0], d->second->attach->rotation[1], d->second->attach->rotation[2], 1);
-				}
+				player.creationBacklog = true;
+				break;
 			}
-			else if (d->second->attach->vehicle != INVALID_VEHICLE_ID)
+			if (!createPlayerObject(player, object, INVALID_STREAMER_ID))
 			{
-				sampgdk::AttachPlayerObjectToVehicle(player.playerId, internalId, d->second->attach->vehicle, d->second->attach->positionOffset[0], d->second->attach->positionOffset[1], d->second->attach->positionOffset[2], d->second->attach->rotation[0], d->second->attach->rotation[1], d->second->attach->rotation[2]);
+				player.currentVisibleObjects = player.internalObjects.size();
+				break;
 			}
+			--count;
+			--limit;
 		}
-		else if (d->second->move)
-		{
-			sampgdk::MovePlayerObject(player.playerId, internalId, std::get<0>(d->second->move->position)[0], std::get<0>(d->second->move->position)[1], std::get<0>(d->second->move->position)[2], d->second->move->speed, std::get<0>(d->second->move->rotation)[0], std::get<0>(d->second->move->rotation)[1], std::get<0>(d->second->move->rotation)[2]);
-		}
-		for (std::unordered_map<int, Item::Object::Material>::iterator m = d->second->materials.begin(); m != d->second->materials.end(); ++m)
+	}
+}
+
+void Streamer::destroyPlayerObject(Player &player, const Item::Object *object, std::unordered_map<int, int>::iterator i)
+{
+	if (player.selectObject == object->objectId)
+	{
+		sampgdk::CancelEdit(player.playerId);
+
+		player.selectObject = 0;
+	}
+	player.playerObjectsIndex[i->second] = 0;
+
+	sampgdk::DestroyPlayerObject(player.playerId, i->second);
+	if (object->streamCallbacks)
+	{
+		streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, object->objectId, player.playerId));
+	}
+	if (!player.streamOutTimes[STREAMER_TYPE_OBJECT].empty())
+	{
+		player.streamOutTimes[STREAMER_TYPE_OBJECT].erase(object->objectId);
+	}
+	player.internalObjects.erase(i);
+}
+
+bool Streamer::createPlayerObject(Player &player, Item::Object *object, int internalBaseId)
+{
+	int internalId = sampgdk::CreatePlayerObject(player.playerId, object->modelId, object->position[0], object->position[1], object->position[2], object->rotation[0], object->rotation[1], object->rotation[2], object->drawDistance);
+	if (internalId == INVALID_OBJECT_ID)
+	{
+		return false;
+	}
+	player.playerObjectsIndex[internalId] = object->objectId;
+	player.playerObjectShootable[internalId] = object->shootable;
+
+	if (object->streamCallbacks)
+	{
+		streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_OBJECT, object->objectId, player.playerId));
+	}
+	if (object->attach)
+	{
+		if (internalBaseId != INVALID_STREAMER_ID)
 		{
-			if (m->second.main)
+			static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
+			if (native != NULL)
 			{
-				sampgdk::SetPlayerObjectMaterial(player.playerId, internalId, m->first, m->second.main->modelId, m->second.main->txdFileName.c_str(), m->second.main->textureName.c_str(), m->second.main->materialColor);
+				Utility::callAttachNative(native, player.playerId, internalId, internalBaseId, object->attach->positionOffset, object->attach->rotation, object->attach->syncRotation);
 			}
-			else if (m->second.text)
+		}
+		else if (object->attach->player != INVALID_PLAYER_ID)
+		{
+			static AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
+			if (native != NULL)
 			{
-				sampgdk::SetPlayerObjectMaterialText(player.playerId, internalId, m->second.text->materialText.c_str(), m->first, m->second.text->materialSize, m->second.text->fontFace.c_str(), m->second.text->fontSize, m->second.text->bold, m->second.text->fontColor, m->second.text->backColor, m->second.text->textAlignment);
+				Utility::callAttachNative(native, player.playerId, internalId, object->attach->player, object->attach->positionOffset, object->attach->rotation, 1);
 			}
 		}
-		if (d->second->noCameraCollision)
+		else if (object->attach->vehicle != INVALID_VEHICLE_ID)
 		{
-			sampgdk::SetPlayerObjectNoCameraCol(player.playerId, internalId);
+			sampgdk::AttachPlayerObjectToVehicle(player.playerId, internalId, object->attach->vehicle, object->attach->positionOffset[0], object->attach->positionOffset[1], object->attach->positionOffset[2], object->attach->rotation[0], object->attach->rotation[1], object->attach->rotation[2]);
 		}
-		player.internalObjects.insert(std::make_pair(d->second->objectId, internalId));
-		if (d->second->cell)
+	}
+	else if (object->move)
+	{
+		sampgdk::MovePlayerObject(player.playerId, internalId, std::get<0>(object->move->position)[0], std::get<0>(object->move->position)[1], std::get<0>(object->move->position)[2], object->move->speed, std::get<0>(object->move->rotation)[0], std::get<0>(object->move->rotation)[1], std::get<0>(object->move->rotation)[2]);
+	}
+	for (std::unordered_map<int, Item::Object::Material>::iterator m = object->materials.begin(); m != object->materials.end(); ++m)
+	{
+		if (m->second.main)
+		{
+			sampgdk::SetPlayerObjectMaterial(player.playerId, internalId, m->first, m->second.main->modelId, m->second.main->txdFileName.c_str(), m->second.main->textureName.c_str(), m->second.main->materialColor);
+		}
+		else if (m->second.text)
+		{
+			sampgdk::SetPlayerObjectMaterialText(player.playerId, internalId, m->second.text->materialText.c_str(), m->first, m->second.text->materialSize, m->second.text->fontFace.c_str(), m->second.text->fontSize, m->second.text->bold, m->second.text->fontColor, m->second.text->backColor, m->second.text->textAlignment);
+		}
+	}
+	if (object->noCameraCollision)
+	{
+		sampgdk::SetPlayerObjectNoCameraCol(player.playerId, internalId);
+	}
+	player.internalObjects.insert(std::make_pair(object->objectId, internalId));
+	if (object->cell)
+	{
+		std::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(object->objectId);
+		if (o != core->getData()->objects.end())
 		{
-			player.visibleCell->objects.insert(std::make_pair(d->second->objectId, d->second));
+			player.visibleCell->objects.insert(*o);
 		}
 	}
+	return true;
 }
 
-void Streamer::discoverPickups(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::discoverPickups(Player &player, const std::vector<Cell*> &cells)
 {
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedPickup>::const_iterator p = (*c)->pickups.begin(); p != (*c)->pickups.end(); ++p)
 		{
-			std::unordered_set<int> worlds = p->second->worlds;
-			if (worlds.empty())
+			if (p->second->worlds.empty())
 			{
-				worlds.insert(-1);
+				discoverPickup(player, p->second, -1);
+				continue;
 			}
-
-			for (std::unordered_set<int>::const_iterator w = worlds.begin(); w != worlds.end(); ++w)
+			for (std::unordered_set<int>::const_iterator w = p->second->worlds.begin(); w != p->second->worlds.end(); ++w)
 			{
-				if (player.worldId != *w && *w != -1)
+				if (player.worldId == *w || *w == -1)
 				{
-					continue;
+					discoverPickup(player, p->second, *w);
 				}
+			}
+		}
+	}
+}
 
-				std::unordered_map<std::pair<int, int>, Item::SharedPickup, pair_hash>::iterator d = core->getData()->discoveredPickups.find(std::make_pair(p->first, *w));
-				if (d == core->getData()->discoveredPickups.end())
-				{
-					const int playerWorldId = *w == -1 ? -1 : player.worldId;
-					if (doesPlayerSatisfyConditions(p->second->players, player.playerId, p->second->interiors, player.interiorId, p->second->worlds, playerWorldId, p->second->areas, player.internalAreas, p->second->inverseAreaChecking))
-					{
-						if (p->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(p->second->position + p->second->positionOffset)) < (p->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_PICKUP]))
-						{
-							core->getData()->discoveredPickups.insert(std::make_pair(std::make_pair(p->first, *w), p->second));
-						}
-					}
-				}
+void Streamer::discoverPickup(Player &player, const Item::SharedPickup &pickup, int worldId)
+{
+	std::unordered_map<std::pair<int, int>, Item::SharedPickup, pair_hash>::iterator d = core->getData()->discoveredPickups.find(std::make_pair(pickup->pickupId, worldId));
+	if (d == core->getData()->discoveredPickups.end())
+	{
+		const int playerWorldId = worldId == -1 ? -1 : player.worldId;
+		if (doesPlayerSatisfyConditions(pickup->players, player.playerId, pickup->interiors, player.interiorId, pickup->worlds, playerWorldId, pickup->areas, player.internalAreas, pickup->inverseAreaChecking))
+		{
+			if (pickup->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(pickup->position + pickup->positionOffset)) < (pickup->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_PICKUP]))
+			{
+				core->getData()->discoveredPickups.insert(std::make_pair(std::make_pair(pickup->pickupId, worldId), pickup));
 			}
 		}
 	}
@@ -1072,35 +1915,39 @@ void Streamer::streamPickups()
 			++i;
 		}
 	}
-	std::multimap<int, std::pair<int, Item::SharedPickup> > sortedPickups;
+	sortedPickups.clear();
 	for (std::unordered_map<std::pair<int, int>, Item::SharedPickup, pair_hash>::iterator d = core->getData()->discoveredPickups.begin(); d != core->getData()->discoveredPickups.end(); ++d)
 	{
-		sortedPickups.insert(std::make_pair(d->second->priority, std::make_pair(d->first.second, d->second)));
+		sortedPickups.push_back(std::make_pair(d->second->priority, std::make_pair(d->first.second, d->second.get())));
 	}
 	core->getData()->discoveredPickups.clear();
-	for (std::multimap<int, std::pair<int, Item::SharedPickup> >::iterator s = sortedPickups.begin(); s != sortedPickups.end(); ++s)
+	std::make_heap(sortedPickups.begin(), sortedPickups.end(), Item::LowestPriorityFirstCompare<std::pair<int, Item::Pickup*> >());
+	while (!sortedPickups.empty())
 	{
 		if (core->getData()->internalPickups.size() == core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_PICKUP))
 		{
 			break;
 		}
-		int internalId = sampgdk::CreatePickup(s->second.second->modelId, s->second.second->type, s->second.second->position[0], s->second.second->position[1], s->second.second->position[2], s->second.first);
+		std::pop_heap(sortedPickups.begin(), sortedPickups.end(), Item::LowestPriorityFirstCompare<std::pair<int, Item::Pickup*> >());
+		std::pair<int, Item::Pickup*> s = sortedPickups.back().second;
+		sortedPickups.pop_back();
+		int internalId = sampgdk::CreatePickup(s.second->modelId, s.second->type, s.second->position[0], s.second->position[1], s.second->position[2], s.first);
 		if (internalId == INVALID_PICKUP_ID)
 		{
 			break;
 		}
-		if (s->second.second->streamCallbacks)
+		if (s.second->streamCallbacks)
 		{
-			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_PICKUP, s->second.second->pickupId, INVALID_PLAYER_ID));
+			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_PICKUP, s.second->pickupId, INVALID_PLAYER_ID));
 		}
-		core->getData()->internalPickups.insert(std::make_pair(std::make_pair(s->second.second->pickupId, s->second.first), internalId));
+		core->getData()->internalPickups.insert(std::make_pair(std::make_pair(s.second->pickupId, s.first), internalId));
 	}
 }
 
-void Streamer::processRaceCheckpoints(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processRaceCheckpoints(Player &player, const std::vector<Cell*> &cells)
 {
-	std::multimap<std::pair<int, float>, Item::SharedRaceCheckpoint, Item::PairCompare> discoveredRaceCheckpoints;
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	std::pair<std::pair<int, float>, Item::SharedRaceCheckpoint> discoveredRaceCheckpoint;
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedRaceCheckpoint>::const_iterator r = (*c)->raceCheckpoints.begin(); r != (*c)->raceCheckpoints.end(); ++r)
 		{
@@ -1118,7 +1965,11 @@ void Streamer::processRaceCheckpoints(Player &player, const std::vector<SharedCe
 			}
 			if (distance < (r->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_RACE_CP]))
 			{
-				discoveredRaceCheckpoints.insert(std::make_pair(std::make_pair(r->second->priority, distance), r->second));
+				std::pair<int, float> key = std::make_pair(r->second->priority, distance);
+				if (!discoveredRaceCheckpoint.second || Item::PairCompare()(key, discoveredRaceCheckpoint.first))
+				{
+					discoveredRaceCheckpoint = std::make_pair(key, r->second);
+				}
 			}
 			else
 			{
@@ -1135,9 +1986,9 @@ void Streamer::processRaceCheckpoints(Player &player, const std::vector<SharedCe
 			}
 		}
 	}
-	if (!discoveredRaceCheckpoints.empty())
+	if (discoveredRaceCheckpoint.second)
 	{
-		std::multimap<std::pair<int, float>, Item::SharedRaceCheckpoint, Item::PairCompare>::iterator d = discoveredRaceCheckpoints.begin();
+		const std::pair<std::pair<int, float>, Item::SharedRaceCheckpoint> *d = &discoveredRaceCheckpoint;
 		if (d->second->raceCheckpointId != player.visibleRaceCheckpoint)
 		{
 			if (player.visibleRaceCheckpoint)
@@ -1158,91 +2009,133 @@ void Streamer::processRaceCheckpoints(Player &player, const std::vector<SharedCe
 	}
 }
 
-void Streamer::processTextLabels(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processTextLabels(Player &player, const std::vector<Cell*> &cells)
+{
+	discoveredTextLabels.clear();
+	existingTextLabels.clear();
+	discoverTextLabels(player, cells);
+	streamTextLabels(player);
+}
+
+void Streamer::discoverTextLabels(Player &player, const std::vector<Cell*> &cells)
 {
-	std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::PairCompare> discoveredTextLabels, existingTextLabels;
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	for (std::vector<Cell*>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
 		for (std::unordered_map<int, Item::SharedTextLabel>::const_iterator t = (*c)->textLabels.begin(); t != (*c)->textLabels.end(); ++t)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(t->second->players, player.playerId, t->second->interiors, player.interiorId, t->second->attach ? t->second->attach->worlds : t->second->worlds, player.worldId, t->second->areas, player.internalAreas, t->second->inverseAreaChecking))
+			discoverTextLabel(player, t->second);
+		}
+	}
+}
+
+void Streamer::discoverTextLabel(Player &player, const Item::SharedTextLabel &textLabel)
+{
+	float distance = std::numeric_limits<float>::infinity();
+	if (doesPlayerSatisfyConditions(textLabel->players, player.playerId, textLabel->interiors, player.interiorId, textLabel->attach ? textLabel->attach->worlds : textLabel->worlds, player.worldId, textLabel->areas, player.internalAreas, textLabel->inverseAreaChecking))
+	{
+		if (textLabel->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			if (textLabel->attach)
 			{
-				if (t->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
-				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
-				}
-				else
-				{
-					if (t->second->attach)
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, t->second->attach->position));
-					}
-					else
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(t->second->position + t->second->positionOffset)));
-					}
-				}
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, textLabel->attach->position));
 			}
-			std::unordered_map<int, int>::iterator i = player.internalTextLabels.find(t->first);
-			if (distance < (t->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL]))
+			else
 			{
-				if (i == player.internalTextLabels.end())
-				{
-					discoveredTextLabels.insert(std::make_pair(std::make_pair(t->second->priority, distance), t->second));
-				}
-				else
-				{
-					if (t->second->cell)
-					{
-						player.visibleCell->textLabels.insert(*t);
-					}
-					existingTextLabels.insert(std::make_pair(std::make_pair(t->second->priority, distance), t->second));
-				}
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(textLabel->position + textLabel->positionOffset)));
 			}
-			else
+		}
+	}
+	std::unordered_map<int, int>::iterator i = player.internalTextLabels.find(textLabel->textLabelId);
+	float comparableStreamDistance = textLabel->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL];
+	if (i != player.internalTextLabels.end())
+	{
+		comparableStreamDistance = getComparableStreamOutDistance(comparableStreamDistance, textLabel->streamOutMargin);
+	}
+	if (safeDistanceSkip)
+	{
+		restrictSafeDistance(player, distance, comparableStreamDistance, textLabel->attach || !textLabel->areas.empty());
+	}
+	if (i == player.internalTextLabels.end() ? distance < comparableStreamDistance : isWithinStreamOutRange(player.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL], textLabel->textLabelId, distance, comparableStreamDistance, textLabel->streamOutGrace))
+	{
+		if (i == player.internalTextLabels.end())
+		{
+			discoveredTextLabels.push_back(std::make_pair(std::make_pair(textLabel->priority, distance), textLabel.get()));
+		}
+		else
+		{
+			if (textLabel->cell)
 			{
-				if (i != player.internalTextLabels.end())
-				{
-					sampgdk::DeletePlayer3DTextLabel(player.playerId, i->second);
-					if (t->second->streamCallbacks)
-					{
-						streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, t->first, player.playerId));
-					}
-					player.internalTextLabels.erase(i);
-				}
+				player.visibleCell->textLabels.insert(std::make_pair(textLabel->textLabelId, textLabel));
 			}
+			existingTextLabels.push_back(std::make_pair(std::make_pair(textLabel->priority, distance), textLabel.get()));
 		}
 	}
-	for (std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::PairCompare>::iterator d = discoveredTextLabels.begin(); d != discoveredTextLabels.end(); ++d)
+	else
 	{
-		std::unordered_map<int, int>::iterator i = player.internalTextLabels.find(d->second->textLabelId);
+		if (i != player.internalTextLabels.end())
+		{
+			sampgdk::DeletePlayer3DTextLabel(player.playerId, i->second);
+			if (textLabel->streamCallbacks)
+			{
+				streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, textLabel->textLabelId, player.playerId));
+			}
+			player.internalTextLabels.erase(i);
+		}
+	}
+}
+
+void Streamer::streamTextLabels(Player &player, std::size_t limit)
+{
+	std::make_heap(discoveredTextLabels.begin(), discoveredTextLabels.end(), Item::BestFirstCompare<Item::TextLabel*>());
+	std::make_heap(existingTextLabels.begin(), existingTextLabels.end(), Item::WorstFirstCompare<Item::TextLabel*>());
+	while (!discoveredTextLabels.empty())
+	{
+		std::pop_heap(discoveredTextLabels.begin(), discoveredTextLabels.end(), Item::BestFirstCompare<Item::TextLabel*>());
+		std::pair<std::pair<int, float>, Item::TextLabel*> d = std::move(discoveredTextLabels.back());
+		discoveredTextLabels.pop_back();
+		std::unordered_map<int, int>::iterator i = player.internalTextLabels.find(d.second->textLabelId);
 		if (i != player.internalTextLabels.end())
 		{
 			continue;
 		}
+		if (!limit || !reserveCreationBytes(getCreationCost(d.second)))
+		{
+			player.safeDistance = 0.0f;
+			player.creationBacklog = true;
+			break;
+		}
 		if (player.internalTextLabels.size() == player.currentVisibleTextLabels)
 		{
-			std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::PairCompare>::reverse_iterator e = existingTextLabels.rbegin();
-			if (e != existingTextLabels.rend())
+			player.safeDistance = 0.0f;
+			if (!existingTextLabels.empty())
 			{
-				if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+				const std::pair<std::pair<int, float>, Item::TextLabel*> &e = existingTextLabels.front();
+				if (e.first.first < d.first.first || (e.first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d.first.second < e.first.second))
 				{
-					std::unordered_map<int, int>::iterator j = player.internalTextLabels.find(e->second->textLabelId);
+					std::unordered_map<int, int>::iterator j = player.internalTextLabels.find(e.second->textLabelId);
 					if (j != player.internalTextLabels.end())
 					{
 						sampgdk::DeletePlayer3DTextLabel(player.playerId, j->second);
-						if (e->second->streamCallbacks)
+						if (e.second->streamCallbacks)
 						{
-							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, e->second->textLabelId, player.playerId));
+							streamOutCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, e.second->textLabelId, player.playerId));
 						}
 						player.internalTextLabels.erase(j);
 					}
-					if (e->second->cell)
+					if (e.second->cell)
+					{
+						player.visibleCell->textLabels.erase(e.second->textLabelId);
+					}
+					if (!player.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL].empty())
 					{
-						player.visibleCell->textLabels.erase(e->second->textLabelId);
+						player.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL].erase(e.second->textLabelId);
 					}
-					existingTextLabels.erase(--e.base());
+					std::pop_heap(existingTextLabels.begin(), existingTextLabels.end(), Item::WorstFirstCompare<Item::TextLabel*>());
+					existingTextLabels.pop_back();
 				}
 			}
 		}
@@ -1251,20 +2144,26 @@ void Streamer::processTextLabels(Player &player, const std::vector<SharedCell> &
 			player.currentVisibleTextLabels = player.internalTextLabels.size();
 			break;
 		}
-		int internalId = sampgdk::CreatePlayer3DTextLabel(player.playerId, d->second->text.c_str(), d->second->color, d->second->position[0], d->second->position[1], d->second->position[2], d->second->drawDistance, d->second->attach ? d->second->attach->player : INVALID_PLAYER_ID, d->second->attach ? d->second->attach->vehicle : INVALID_VEHICLE_ID, d->second->testLOS);
+		int internalId = sampgdk::CreatePlayer3DTextLabel(player.playerId, d.second->text.c_str(), d.second->color, d.second->position[0], d.second->position[1], d.second->position[2], d.second->drawDistance, d.second->attach ? d.second->attach->player : INVALID_PLAYER_ID, d.second->attach ? d.second->attach->vehicle : INVALID_VEHICLE_ID, d.second->testLOS);
 		if (internalId == INVALID_3DTEXT_ID)
 		{
+			player.safeDistance = 0.0f;
 			player.currentVisibleTextLabels = player.internalTextLabels.size();
 			break;
 		}
-		if (d->second->streamCallbacks)
+		if (d.second->streamCallbacks)
 		{
-			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, d->second->textLabelId, player.playerId));
+			streamInCallbacks.push_back(std::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, d.second->textLabelId, player.playerId));
 		}
-		player.internalTextLabels.insert(std::make_pair(d->second->textLabelId, internalId));
-		if (d->second->cell)
+		player.internalTextLabels.insert(std::make_pair(d.second->textLabelId, internalId));
+		--limit;
+		if (d.second->cell)
 		{
-			player.visibleCell->textLabels.insert(std::make_pair(d->second->textLabelId, d->second));
+			std::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(d.second->textLabelId);
+			if (t != core->getData()->textLabels.end())
+			{
+				player.visibleCell->textLabels.insert(*t);
+			}
 		}
 	}
 }
@@ -26,12 +26,18 @@ class Streamer
 {
 public:
 	Streamer();
+	~Streamer();
 
 	inline float getLastUpdateTime()
 	{
 		return lastUpdateTime;
 	}
 
+	inline std::size_t getTickAllocations()
+	{
+		return tickAllocations;
+	}
+
 	inline std::size_t getTickRate()
 	{
 		return tickRate;
@@ -46,6 +52,138 @@ public:
 		}
 		return false;
 	}
+
+	inline std::size_t getTickBudget()
+	{
+		return tickBudget;
+	}
+
+	inline void setTickBudget(std::size_t value)
+	{
+		tickBudget = value;
+		if (!tickBudget)
+		{
+			updateQueue.clear();
+			queuedPlayers.clear();
+		}
+	}
+
+	inline std::size_t getUpdateQueueSize()
+	{
+		return updateQueue.size();
+	}
+
+	inline float getUpdateQueueDelay()
+	{
+		if (!updateQueue.empty())
+		{
+			return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateQueue.front().second).count();
+		}
+		return 0.0f;
+	}
+
+	inline bool getStaggeredUpdates()
+	{
+		return staggeredUpdates;
+	}
+
+	inline void setStaggeredUpdates(bool enabled)
+	{
+		staggeredUpdates = enabled;
+	}
+
+	inline std::size_t getWorkerThreads()
+	{
+		return workerThreads;
+	}
+
+	bool setWorkerThreads(std::size_t value);
+
+	inline std::tuple<float, float> getVerticalRanges()
+	{
+		return verticalRanges;
+	}
+
+	inline void setVerticalRanges(float streamRange, float createRange)
+	{
+		verticalRanges = std::make_tuple(std::fabs(streamRange), std::fabs(createRange));
+	}
+
+	inline std::tuple<float, int> getStreamOutHysteresis()
+	{
+		return std::make_tuple(streamOutMargin, streamOutGrace);
+	}
+
+	inline void setStreamOutHysteresis(float margin, int grace)
+	{
+		streamOutMargin = std::max(margin, 0.0f);
+		streamOutGrace = std::max(grace, 0);
+	}
+
+	inline float getComparableStreamOutDistance(float comparableStreamDistance, float margin)
+	{
+		if (margin < 0.0f)
+		{
+			margin = streamOutMargin;
+		}
+		return comparableStreamDistance * (1.0f + margin) * (1.0f + margin);
+	}
+
+	inline void eraseActorStreamOutTime(const std::pair<int, int> &actor)
+	{
+		if (!actorStreamOutTimes.empty())
+		{
+			actorStreamOutTimes.erase(actor);
+		}
+	}
+
+	inline std::size_t getPrefetchUpdates()
+	{
+		return prefetchUpdates;
+	}
+
+	inline void setPrefetchUpdates(std::size_t value)
+	{
+		prefetchUpdates = value;
+	}
+
+	inline std::size_t getCreationBudget()
+	{
+		return creationBudget;
+	}
+
+	inline void setCreationBudget(std::size_t value)
+	{
+		creationBudget = value;
+	}
+
+	inline std::size_t getByteBudget()
+	{
+		return byteBudget;
+	}
+
+	inline void setByteBudget(std::size_t value)
+	{
+		byteBudget = value;
+	}
+
+	inline bool getSafeDistanceSkip()
+	{
+		return safeDistanceSkip;
+	}
+
+	inline void setSafeDistanceSkip(bool enabled)
+	{
+		safeDistanceSkip = enabled;
+		++itemVersion;
+	}
+
+	inline void invalidateSafeDistances()
+	{
+		++itemVersion;
+	}
+
+	void markItemDirty(int type, int id);
 	void startAutomaticUpdate();
 	void startManualUpdate(Player &player, int type);
 	void createObjectForPlayers(const Item::SharedObject &object);
@@ -65,21 +203,80 @@ private:
 
 	void executeCallbacks();
 
+	struct PlayerUpdate
+	{
+		Player *player;
+		bool automatic;
+		bool update;
+		bool withinSafeDistance;
+		bool idle;
+		bool objectsDiscovered;
+		Eigen::Vector3f delta;
+		Eigen::Vector3f position;
+		std::vector<Cell*> cells;
+		std::vector<std::pair<std::pair<int, float>, Item::Object*> > discoveredObjects;
+		std::vector<std::pair<std::pair<int, float>, Item::Object*> > existingObjects;
+		std::vector<Item::Object*> removedObjects;
+		std::vector<std::pair<std::pair<int, float>, Item::Object*> > prefetchedObjects;
+	};
+
+	void processUpdateQueue(const std::chrono::steady_clock::time_point &startTime);
+	bool isPlayerUpdateDue(Player &player, bool globalUpdate);
 	void performPlayerUpdate(Player &player, bool automatic);
+	void performParallelPlayerUpdates(bool globalUpdate);
+	void discoverPlayerUpdates(std::size_t count, std::atomic<std::size_t> &index);
+	void runWorker(std::size_t generation);
+	void stopWorkers();
+	void preparePlayerUpdate(PlayerUpdate &playerUpdate, bool automatic);
+	void discoverPlayerUpdate(PlayerUpdate &playerUpdate, bool objects);
+	void applyPlayerUpdate(PlayerUpdate &playerUpdate, bool automatic);
+	void restrictSafeDistance(Player &player, float comparableDistance, float comparableStreamDistance, bool dynamic);
 
-	void discoverActors(Player &player, const std::vector<SharedCell> &cells);
+	void discoverActors(Player &player, const std::vector<Cell*> &cells);
+	void discoverActor(Player &player, const Item::SharedActor &actor, int worldId);
 	void streamActors();
 
-	void processAreas(Player &player, const std::vector<SharedCell> &cells);
-	void processCheckpoints(Player &player, const std::vector<SharedCell> &cells);
-	void processRaceCheckpoints(Player &player, const std::vector<SharedCell> &cells);
-	void processMapIcons(Player &player, const std::vector<SharedCell> &cells);
-	void processObjects(Player &player, const std::vector<SharedCell> &cells);
+	void processAreas(Player &player, const std::vector<Cell*> &cells);
+	void processCheckpoints(Player &player, const std::vector<Cell*> &cells);
+	void processRaceCheckpoints(Player &player, const std::vector<Cell*> &cells);
+	void processMapIcons(Player &player, const std::vector<Cell*> &cells);
+	void discoverMapIcon(Player &player, const Item::SharedMapIcon &mapIcon);
+	void discoverMapIcons(Player &player, const std::vector<Cell*> &cells);
+	void streamMapIcons(Player &player, std::size_t limit = std::numeric_limits<std::size_t>::max());
+	void discoverObject(Player &player, const Item::SharedObject &object, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects);
+	void discoverFrozenObject(Player &player, const Item::FrozenObject &object, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects);
+	void discoverObjects(Player &player, const std::vector<Cell*> &cells, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects);
+	void processObjects(Player &player, const std::vector<Cell*> &cells);
+	void streamObjects(Player &player, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &discoveredObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &existingObjects, const std::vector<Item::Object*> &removedObjects, std::vector<std::pair<std::pair<int, float>, Item::Object*> > &prefetchedObjects, std::size_t limit = std::numeric_limits<std::size_t>::max());
+	float getPrefetchArrival(const Eigen::Vector3f &position, const Eigen::Vector3f &offset, const Eigen::Vector3f &target, float comparableStreamDistance);
 
-	void discoverPickups(Player &player, const std::vector<SharedCell> &cells);
+	void discoverPickups(Player &player, const std::vector<Cell*> &cells);
+	void discoverPickup(Player &player, const Item::SharedPickup &pickup, int worldId);
 	void streamPickups();
 	
-	void processTextLabels(Player &player, const std::vector<SharedCell> &cells);
+	void processTextLabels(Player &player, const std::vector<Cell*> &cells);
+	void discoverTextLabel(Player &player, const Item::SharedTextLabel &textLabel);
+	void discoverTextLabels(Player &player, const std::vector<Cell*> &cells);
+	void streamTextLabels(Player &player, std::size_t limit = std::numeric_limits<std::size_t>::max());
+
+	void processDirtyItems(Player &player);
+	void trimDirtyItems();
+	void trackScratchAllocations();
+	void streamBudgetedItems(PlayerUpdate &playerUpdate, std::size_t budget);
+
+	std::size_t getCreationCost(const Item::MapIcon *mapIcon);
+	std::size_t getCreationCost(const Item::Object *object);
+	std::size_t getCreationCost(const Item::TextLabel *textLabel);
+
+	inline bool reserveCreationBytes(std::size_t cost)
+	{
+		if (cost > creationBytes && creationBytes != byteBudget)
+		{
+			return false;
+		}
+		creationBytes -= std::min(creationBytes, cost);
+		return true;
+	}
 
 	void processMovingObjects();
 	void processAttachedAreas();
@@ -88,19 +285,108 @@ private:
 
 	std::size_t tickCount;
 	std::size_t tickRate;
+	std::size_t workerThreads;
+	bool staggeredUpdates;
+	std::size_t tickBudget;
+	bool safeDistanceSkip;
+	std::size_t itemVersion;
+	float streamOutMargin;
+	int streamOutGrace;
+	std::size_t prefetchUpdates;
+	std::size_t creationBudget;
+	std::size_t byteBudget;
+	std::size_t creationBytes;
+
+	std::deque<std::pair<int, int> > dirtyItems;
+	std::size_t dirtyItemsBase;
+
+	std::unordered_map<std::pair<int, int>, std::chrono::steady_clock::time_point, pair_hash> actorStreamOutTimes;
+
+	std::deque<std::pair<int, std::chrono::steady_clock::time_point> > updateQueue;
+	std::unordered_set<int> queuedPlayers;
+
+	std::size_t scratchCapacity;
+	std::size_t tickAllocations;
+
+	std::vector<PlayerUpdate> playerUpdates;
+
+	std::vector<std::thread> workers;
+	std::mutex workerMutex;
+	std::condition_variable workerStart;
+	std::condition_variable workerDone;
+	std::atomic<std::size_t> workerIndex;
+	std::size_t workerGeneration;
+	std::size_t workerJobs;
+	std::size_t workerPending;
+	bool workerShutdown;
+
+	std::vector<std::pair<std::pair<int, float>, Item::MapIcon*> > discoveredMapIcons, existingMapIcons;
+	std::vector<std::pair<std::pair<int, float>, Item::Object*> > discoveredObjects, existingObjects;
+	std::vector<Item::Object*> removedObjects;
+	std::vector<std::pair<std::pair<int, float>, Item::Object*> > prefetchedObjects;
+	std::vector<std::pair<std::pair<int, float>, Item::TextLabel*> > discoveredTextLabels, existingTextLabels;
+	std::vector<std::pair<std::pair<int, float>, int> > creationQueue;
 
 	float averageElapsedTime;
 	float lastUpdateTime;
 
 	std::tuple<float, float> velocityBoundaries;
+	std::tuple<float, float> verticalRanges;
+
+	std::vector<std::pair<int, std::pair<int, Item::Actor*> > > sortedActors;
+	std::vector<std::pair<int, std::pair<int, Item::Pickup*> > > sortedPickups;
 
-	std::multimap<int, std::tuple<int, int> > areaEnterCallbacks;
-	std::multimap<int, std::tuple<int, int> > areaLeaveCallbacks;
+	std::vector<std::pair<int, std::tuple<int, int> > > areaEnterCallbacks;
+	std::vector<std::pair<int, std::tuple<int, int> > > areaLeaveCallbacks;
+	std::vector<std::pair<int, std::tuple<int, int> > > areaCallbacks;
 
 	std::vector<int> objectMoveCallbacks;
+	std::vector<int> moveCallbacks;
 protected:
 	std::vector<std::tuple<int, int, int> > streamInCallbacks;
 	std::vector<std::tuple<int, int, int> > streamOutCallbacks;
+	std::vector<std::tuple<int, int, int> > streamCallbacks;
+
+	float getObjectDistance(Player &player, const Item::SharedObject &object);
+	float getObjectStreamDistance(Player &player, const Item::SharedObject &object, bool visible);
+	bool createPlayerObject(Player &player, Item::Object *object, int internalBaseId);
+	void destroyPlayerObject(Player &player, const Item::Object *object, std::unordered_map<int, int>::iterator i);
+
+	template<typename T, typename U>
+	inline bool isWithinStreamOutRange(T &times, const U &id, float distance, float comparableStreamDistance, int grace)
+	{
+		if (distance < comparableStreamDistance)
+		{
+			if (!times.empty())
+			{
+				times.erase(id);
+			}
+			return true;
+		}
+		if (grace < 0)
+		{
+			grace = streamOutGrace;
+		}
+		if (grace > 0 && std::isfinite(distance))
+		{
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			typename T::iterator t = times.find(id);
+			if (t == times.end())
+			{
+				times.insert(std::make_pair(id, now));
+				return true;
+			}
+			if (std::chrono::duration_cast<std::chrono::milliseconds>(now - t->second).count() < grace)
+			{
+				return true;
+			}
+		}
+		if (!times.empty())
+		{
+			times.erase(id);
+		}
+		return false;
+	}
 
 	template<std::size_t N, typename T>
 	inline bool doesPlayerSatisfyConditions(const std::bitset<N> &a, const T &b, const std::unordered_set<T> &c, const T &d, const std::unordered_set<T> &e, const T &f)
@@ -26,6 +26,23 @@ cell AMX_NATIVE_CALL Utility::hookedNative(AMX *amx, cell *params)
 	return 1;
 }
 
+cell Utility::callAttachNative(AMX_NATIVE native, int playerId, int objectId, int targetId, const Eigen::Vector3f &positionOffset, const Eigen::Vector3f &rotation, int flag)
+{
+	cell params[11];
+	params[0] = 10 * sizeof(cell);
+	params[1] = static_cast<cell>(playerId);
+	params[2] = static_cast<cell>(objectId);
+	params[3] = static_cast<cell>(targetId);
+	params[4] = amx_ftoc(positionOffset[0]);
+	params[5] = amx_ftoc(positionOffset[1]);
+	params[6] = amx_ftoc(positionOffset[2]);
+	params[7] = amx_ftoc(rotation[0]);
+	params[8] = amx_ftoc(rotation[1]);
+	params[9] = amx_ftoc(rotation[2]);
+	params[10] = static_cast<cell>(flag);
+	return sampgdk::CallNative(native, params);
+}
+
 int Utility::checkInterfaceAndRegisterNatives(AMX *amx, AMX_NATIVE_INFO *amxNativeList)
 {
 	AMX_HEADER *amxHeader = reinterpret_cast<AMX_HEADER*>(amx->base);
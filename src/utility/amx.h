@@ -25,6 +25,7 @@
 namespace Utility
 {
 	cell AMX_NATIVE_CALL hookedNative(AMX *amx, cell *params);
+	cell callAttachNative(AMX_NATIVE native, int playerId, int objectId, int targetId, const Eigen::Vector3f &positionOffset, const Eigen::Vector3f &rotation, int flag);
 
 	int checkInterfaceAndRegisterNatives(AMX *amx, AMX_NATIVE_INFO *amxNativeList);
 	void destroyAllItemsInInterface(AMX *amx);
@@ -30,6 +30,7 @@ std::unordered_map<int, Item::SharedActor>::iterator Utility::destroyActor(std::
 		if (i != core->getData()->internalActors.end())
 		{
 			core->getData()->destroyedActors.push_back(i->second);
+			core->getStreamer()->eraseActorStreamOutTime(i->first);
 			core->getData()->internalActors.erase(i);
 		}
 		std::unordered_map<std::pair<int, int>, Item::SharedActor, pair_hash>::iterator d = core->getData()->discoveredActors.find(std::make_pair(a->first, *w));
@@ -49,6 +50,7 @@ std::unordered_map<int, Item::SharedArea>::iterator Utility::destroyArea(std::un
 	{
 		p->second.internalAreas.erase(a->first);
 		p->second.visibleCell->areas.erase(a->first);
+		p->second.outsideCell->areas.erase(a->first);
 	}
 	core->getGrid()->removeArea(a->second);
 	return core->getData()->areas.erase(a);
@@ -66,6 +68,7 @@ std::unordered_map<int, Item::SharedCheckpoint>::iterator Utility::destroyCheckp
 			p->second.visibleCheckpoint = 0;
 		}
 		p->second.visibleCell->checkpoints.erase(c->first);
+		p->second.outsideCell->checkpoints.erase(c->first);
 	}
 	core->getGrid()->removeCheckpoint(c->second);
 	return core->getData()->checkpoints.erase(c);
@@ -99,6 +102,8 @@ std::unordered_map<int, Item::SharedMapIcon>::iterator Utility::destroyMapIcon(s
 			p->second.removedMapIcons.erase(r);
 		}
 		p->second.visibleCell->mapIcons.erase(m->first);
+		p->second.outsideCell->mapIcons.erase(m->first);
+		p->second.streamOutTimes[STREAMER_TYPE_MAP_ICON].erase(m->first);
 	}
 	core->getGrid()->removeMapIcon(m->second);
 	return core->getData()->mapIcons.erase(m);
@@ -138,6 +143,8 @@ std::unordered_map<int, Item::SharedObject>::iterator Utility::destroyObject(std
 			p->second.removedObjects.erase(r);
 		}
 		p->second.visibleCell->objects.erase(o->first);
+		p->second.outsideCell->objects.erase(o->first);
+		p->second.streamOutTimes[STREAMER_TYPE_OBJECT].erase(o->first);
 	}
 	core->getGrid()->removeObject(o->second);
 	return core->getData()->objects.erase(o);
@@ -176,6 +183,7 @@ std::unordered_map<int, Item::SharedRaceCheckpoint>::iterator Utility::destroyRa
 			p->second.visibleRaceCheckpoint = 0;
 		}
 		p->second.visibleCell->raceCheckpoints.erase(r->first);
+		p->second.outsideCell->raceCheckpoints.erase(r->first);
 	}
 	core->getGrid()->removeRaceCheckpoint(r->second);
 	return core->getData()->raceCheckpoints.erase(r);
@@ -208,6 +216,8 @@ std::unordered_map<int, Item::SharedTextLabel>::iterator Utility::destroyTextLab
 			p->second.removedTextLabels.erase(r);
 		}
 		p->second.visibleCell->textLabels.erase(t->first);
+		p->second.outsideCell->textLabels.erase(t->first);
+		p->second.streamOutTimes[STREAMER_TYPE_3D_TEXT_LABEL].erase(t->first);
 	}
 	core->getGrid()->removeTextLabel(t->second);
 	return core->getData()->textLabels.erase(t);
@@ -395,12 +405,14 @@ bool Utility::setRadiusMultiplier(int type, float value, int playerid)
 			if (p != core->getData()->players.end())
 			{
 				p->second.radiusMultipliers[type] = value;
+				p->second.neighbouringCellsVersion = 0;
 				return true;
 			}
 		}
 		for (std::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 		{
 			p->second.radiusMultipliers[type] = value;
+			p->second.neighbouringCellsVersion = 0;
 		}
 	}
 	return core->getData()->setGlobalRadiusMultiplier(type, value);